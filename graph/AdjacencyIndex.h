@@ -0,0 +1,79 @@
+﻿#ifndef ADJACENCY_INDEX_H
+#define ADJACENCY_INDEX_H
+#include <vector>
+#include <unordered_map>
+#include "Edge.h"
+using namespace std;
+
+//хэш-индекс рёбер одной вершины с большой степенью: конец ребра -> позиции рёбер в него в списке смежности
+//заводится, когда степень доходит до DEGREE_THRESHOLD; для меньших списков линейный просмотр быстрее
+//позиции позволяют удалять рёбра перестановкой последнего на место удаляемого за O(1) на ребро,
+//поэтому порядок рёбер в проиндексированном списке после удалений не сохраняется
+template <class WeightT>
+class BasicAdjacencyIndex {
+private:
+    unordered_multimap<int, int> positionsByTarget;
+
+public:
+    static constexpr size_t DEGREE_THRESHOLD = 32;
+
+    //edges - список рёбер (vector или pmr::vector из BasicEdge)
+    template <class EdgeList>
+    explicit BasicAdjacencyIndex(const EdgeList& edges) {
+        positionsByTarget.reserve(edges.size() * 2);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            positionsByTarget.emplace(edges[i].to, (int)i);
+        }
+    }
+
+    //есть ли хотя бы одно ребро в to
+    bool contains(int to) const {
+        return positionsByTarget.find(to) != positionsByTarget.end();
+    }
+
+    //есть ли в списке edges ребро в to с весом weight
+    template <class EdgeList>
+    bool contains(const EdgeList& edges, int to, WeightT weight) const {
+        auto range = positionsByTarget.equal_range(to);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (edges[it->second].weight == weight) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //ребро в to добавлено в список на позицию position
+    void add(int to, int position) {
+        positionsByTarget.emplace(to, position);
+    }
+
+    //удаляет из списка edges все рёбра в to, ставя на их место последние рёбра списка,
+    //возвращает количество удалённых; O(числа удалённых рёбер)
+    template <class EdgeList>
+    size_t eraseTarget(EdgeList& edges, int to) {
+        size_t erased = 0;
+        for (auto it = positionsByTarget.find(to); it != positionsByTarget.end(); it = positionsByTarget.find(to)) {
+            int position = it->second;
+            positionsByTarget.erase(it);
+            int last = (int)edges.size() - 1;
+            if (position != last) {
+                auto range = positionsByTarget.equal_range(edges[last].to);
+                for (auto moved = range.first; moved != range.second; ++moved) {
+                    if (moved->second == last) {
+                        moved->second = position;
+                        break;
+                    }
+                }
+                edges[position] = edges[last];
+            }
+            edges.pop_back();
+            ++erased;
+        }
+        return erased;
+    }
+};
+
+using AdjacencyIndex = BasicAdjacencyIndex<int>;
+
+#endif  // ADJACENCY_INDEX_H
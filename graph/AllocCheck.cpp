@@ -0,0 +1,80 @@
+﻿#include <cstdlib>
+#include <new>
+#include <atomic>
+#include "AllocCheck.h"
+
+//замена глобальных operator new/delete со счётчиком выделений для alloccheck (только при GRAPH_ALLOC_CHECK)
+//выровненные перегрузки тоже заменяются: через них берёт память pmr::new_delete_resource()
+namespace {
+    atomic<uint64_t> allocations{ 0 };
+}
+
+uint64_t alloccheck::allocationCount() {
+    return allocations.load();
+}
+
+#ifdef GRAPH_ALLOC_CHECK
+#ifdef _MSC_VER
+#include <malloc.h>
+static void* allocateAligned(size_t size, size_t alignment) {
+    return _aligned_malloc(size, alignment);
+}
+static void freeAligned(void* block) {
+    _aligned_free(block);
+}
+#else
+static void* allocateAligned(size_t size, size_t alignment) {
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+static void freeAligned(void* block) {
+    free(block);
+}
+#endif
+
+void* operator new(size_t size) {
+    ++allocations;
+    void* block = malloc(size ? size : 1);
+    if (!block) {
+        throw bad_alloc();
+    }
+    return block;
+}
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+void* operator new(size_t size, align_val_t alignment) {
+    ++allocations;
+    void* block = allocateAligned(size ? size : 1, (size_t)alignment);
+    if (!block) {
+        throw bad_alloc();
+    }
+    return block;
+}
+void* operator new[](size_t size, align_val_t alignment) {
+    return operator new(size, alignment);
+}
+void operator delete(void* block) noexcept {
+    free(block);
+}
+void operator delete[](void* block) noexcept {
+    free(block);
+}
+void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+void operator delete[](void* block, size_t) noexcept {
+    free(block);
+}
+void operator delete(void* block, align_val_t) noexcept {
+    freeAligned(block);
+}
+void operator delete[](void* block, align_val_t) noexcept {
+    freeAligned(block);
+}
+void operator delete(void* block, size_t, align_val_t) noexcept {
+    freeAligned(block);
+}
+void operator delete[](void* block, size_t, align_val_t) noexcept {
+    freeAligned(block);
+}
+#endif
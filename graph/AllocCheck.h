@@ -0,0 +1,71 @@
+﻿#ifndef ALLOC_CHECK_H
+#define ALLOC_CHECK_H
+#include <iostream>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include "Graph.h"
+#include "GraphGenerators.h"
+using namespace std;
+
+//проверка числа выделений памяти (вызовов operator new) в операциях, которые не должны копировать граф лишний раз:
+//загрузка с присваиванием готовому графу и обращение графа
+//выделения считаются только при определённом GRAPH_ALLOC_CHECK (например, /D GRAPH_ALLOC_CHECK):
+//тогда AllocCheck.cpp заменяет глобальные operator new/delete, без него allocationCount() всегда 0
+namespace alloccheck {
+
+#ifdef GRAPH_ALLOC_CHECK
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    //сколько раз с запуска вызывался operator new (все перегрузки, включая выровненные)
+    uint64_t allocationCount();
+
+    //на сколько выделений обращение может превышать копию своего результата: массивы подсчёта,
+    //задачи пула потоков и индексы вершин с большой степенью
+    constexpr uint64_t REVERSE_EXTRA_ALLOCATIONS = 64;
+
+    //выделения памяти при выполнении body
+    template <class F>
+    uint64_t countAllocations(F body) {
+        uint64_t before = allocationCount();
+        body();
+        return allocationCount() - before;
+    }
+
+    //генерирует ориентированный граф, сравнивает счётчики и печатает их; false, если проверка не прошла
+    inline bool run(const string& workFile = "alloc_check_graph.txt") {
+        if (!ENABLED) {
+            cout << "Счёт выделений памяти доступен только в сборке с GRAPH_ALLOC_CHECK" << endl;
+            return false;
+        }
+        gen::GeneratedGraph generated = gen::erdosRenyi(5000, 40000, true, 24);
+        generated.writeEdgeList(workFile);
+        streambuf* console = cout.rdbuf(nullptr); //конструктор графа сообщает о загрузке
+
+        //загрузка в новый граф и загрузка с перемещающим присваиванием уже заполненному графу
+        uint64_t load = countAllocations([&] { Graph loaded(workFile); });
+        Graph target(true);
+        target.addEdge("a", "b", 1);
+        uint64_t loadAssign = countAllocations([&] { target = Graph(workFile); });
+
+        //обращение против копии его результата
+        Graph::ReversedGraph reversed;
+        uint64_t reverse = countAllocations([&] { reversed = target.reverseGraph(); });
+        uint64_t copy = countAllocations([&] { Graph::ReversedGraph copied(reversed); });
+
+        cout.rdbuf(console);
+        remove(workFile.c_str());
+        bool assignOk = loadAssign <= load;
+        bool reverseOk = reverse <= copy + REVERSE_EXTRA_ALLOCATIONS;
+        cout << "Загрузка: " << load << ", загрузка с присваиванием: " << loadAssign
+            << (assignOk ? " - OK" : " - лишние выделения") << endl;
+        cout << "Обращение: " << reverse << ", копия результата: " << copy
+            << (reverseOk ? " - OK" : " - лишние выделения") << endl;
+        return assignOk && reverseOk;
+    }
+}
+
+#endif  // ALLOC_CHECK_H
@@ -0,0 +1,233 @@
+﻿#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include "Graph.h"
+#include "GraphArena.h"
+#include "ThreadPool.h"
+#include "EdgeListParser.h"
+using namespace std;
+
+//пакетный режим без меню: файл запросов читается блоками, запросы блока выполняются параллельно
+//над неизменяемым графом, ответы пишутся в выходной файл в порядке запросов
+//формат файла запросов (пустые строки и строки с # пропускаются):
+//  graph <файл графа>      - первой командой, граф загружается один раз
+//  path <u> <v>            - кратчайший путь (Дейкстра)
+//  haspath <u> <v>         - существует ли путь
+//  within <u> <v> <L>      - путь длиной не более L (Флойд-Уоршелл)
+//  maxflow <u> <v>         - максимальный поток
+//  cut <u> <v> <k>         - можно ли разъединить вершины, удалив не более k рёбер
+//  common <u> <v>          - общая вершина, в которую ведут дуги из u и из v
+//  outdegree <u>           - полустепень исхода
+//в выходном файле на каждый запрос одна строка: текст запроса, табуляция, ответ
+class BatchRunner {
+public:
+    static constexpr int BLOCK_SIZE = 1024;      //запросов в блоке между записями в файл
+
+private:
+    GraphArena arena;                            //память графа, отдаётся целиком при разрушении
+    unique_ptr<Graph> graph;                     //граф только читается, поэтому арена без блокировок подходит
+    ThreadPool pool;                             //свой пул: алгоритмы внутри запросов пользуются общим
+    size_t queryCount = 0;
+
+    static vector<string> split(const string& line) {
+        vector<string> tokens;
+        istringstream stream(line);
+        string token;
+        while (stream >> token) {
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+
+    static int parseNumber(const string& token) {
+        int value;
+        if (!EdgeListParser::parseInt(token, value)) {
+            throw runtime_error("некорректное число " + token);
+        }
+        return value;
+    }
+
+    //индекс вершины или исключение с её именем
+    int vertex(const string& name) const {
+        int index = graph->findVertex(name);
+        if (index == -1) {
+            throw runtime_error("вершина " + name + " не найдена");
+        }
+        return index;
+    }
+
+    string formatPath(const PathResult& path) const {
+        if (!path.found) {
+            return "нет пути";
+        }
+        string text = to_string(path.distance) + ":";
+        for (int v : path.vertices) {
+            text += " ";
+            text += graph->getVertexName(v);
+        }
+        return text;
+    }
+
+    //ответ на один запрос; вызывается параллельно, поэтому только константные методы графа без вывода
+    string answer(const vector<string>& query) const {
+        const string& command = query[0];
+        auto expect = [&](size_t args) {
+            if (query.size() != args + 1) {
+                throw runtime_error("команда " + command + " ожидает аргументов: " + to_string(args));
+            }
+        };
+
+        if (command == "path") {
+            expect(2);
+            vertex(query[1]);
+            vertex(query[2]);
+            return formatPath(graph->findShortestPathDijkstra(query[1], query[2]));
+        }
+        if (command == "haspath") {
+            expect(2);
+            return graph->hasPath(vertex(query[1]), vertex(query[2])) ? "да" : "нет";
+        }
+        if (command == "within") {
+            expect(3);
+            vertex(query[1]);
+            vertex(query[2]);
+            PathResult path = graph->findPathWithinL(query[1], query[2], parseNumber(query[3]));
+            return path.found ? formatPath(path) : "нет пути длиной <= " + query[3];
+        }
+        if (command == "maxflow") {
+            expect(2);
+            vertex(query[1]);
+            vertex(query[2]);
+            return to_string(graph->fordFulkerson(query[1], query[2]).flow);
+        }
+        if (command == "cut") {
+            expect(3);
+            vertex(query[1]);
+            vertex(query[2]);
+            EdgeCutResult cut = graph->canDisconnectWithKEdges(query[1], query[2], parseNumber(query[3]), graph->isDirected());
+            if (cut.alreadyDisconnected) {
+                return "уже отключены";
+            }
+            if (!cut.possible) {
+                return "невозможно";
+            }
+            string text = to_string(cut.cutEdges.size()) + ":";
+            for (const auto& edge : cut.cutEdges) {
+                text += " (";
+                text += graph->getVertexName(edge.first);
+                text += ", ";
+                text += graph->getVertexName(edge.second);
+                text += ")";
+            }
+            return text;
+        }
+        if (command == "common") {
+            expect(2);
+            vertex(query[1]);
+            vertex(query[2]);
+            CommonTargetResult common = graph->findCommonTarget(query[1], query[2]);
+            return common.found ? string(graph->getVertexName(common.vertex)) : "нет общей вершины";
+        }
+        if (command == "outdegree") {
+            expect(1);
+            vertex(query[1]);
+            return to_string(graph->getOutDegree(query[1]));
+        }
+        throw runtime_error("неизвестная команда " + command);
+    }
+
+    //выполняет блок запросов параллельно и дописывает ответы по порядку
+    void runBlock(const vector<string>& lines, ostream& out) {
+        vector<vector<string>> queries(lines.size());
+        bool needsMatrix = false;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            queries[i] = split(lines[i]);
+            needsMatrix = needsMatrix || queries[i][0] == "within";
+        }
+        if (needsMatrix) {
+            graph->getAllPairsShortestPaths(); //матрица строится один раз на общем пуле и дальше берётся из кэша
+        }
+
+        vector<string> answers(lines.size());
+        pool.parallelFor((int)lines.size(), [&](int, int i) {
+            try {
+                answers[i] = answer(queries[i]);
+            }
+            catch (const exception& e) {
+                answers[i] = string("ошибка: ") + e.what();
+            }
+        });
+        for (size_t i = 0; i < lines.size(); ++i) {
+            out << lines[i] << '\t' << answers[i] << '\n';
+        }
+        out.flush();
+        queryCount += lines.size();
+    }
+
+public:
+    //threads - кол-во исполнителей для запросов
+    explicit BatchRunner(int threads = (int)thread::hardware_concurrency()) : pool(threads) {}
+
+    //читает запросы из in и пишет ответы в out; ошибка в отдельном запросе попадает в его ответ,
+    //ошибка формата файла (нет графа) - исключение
+    void run(istream& in, ostream& out) {
+        vector<string> block;
+        string line;
+        while (getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            vector<string> tokens = split(line);
+            if (tokens.empty() || tokens[0][0] == '#') {
+                continue;
+            }
+            if (tokens[0] == "graph") {
+                if (graph || tokens.size() != 2) {
+                    throw runtime_error("Команда graph должна быть первой и единственной: " + line);
+                }
+                graph = make_unique<Graph>(tokens[1], DuplicatePolicy::SkipExact, &arena);
+                continue;
+            }
+            if (!graph) {
+                throw runtime_error("Файл запросов должен начинаться с команды graph <файл графа>");
+            }
+            block.push_back(line);
+            if ((int)block.size() == BLOCK_SIZE) {
+                runBlock(block, out);
+                block.clear();
+            }
+        }
+        if (!block.empty()) {
+            runBlock(block, out);
+        }
+    }
+
+    //пакетная обработка файла запросов; ответы пишутся в outputFile
+    void runFile(const string& queriesFile, const string& outputFile) {
+        ifstream in(queriesFile);
+        if (!in) {
+            throw runtime_error("Ошибка открытия файла запросов " + queriesFile);
+        }
+        ofstream out(outputFile);
+        if (!out) {
+            throw runtime_error("Ошибка открытия файла для записи!");
+        }
+        run(in, out);
+        if (!out) {
+            throw runtime_error("Ошибка записи ответов в файл " + outputFile);
+        }
+        cout << "Выполнено запросов: " << queryCount << ", ответы записаны в " << outputFile << endl;
+    }
+
+    size_t getQueryCount() const {
+        return queryCount;
+    }
+};
+
+#endif  // BATCH_RUNNER_H
@@ -0,0 +1,221 @@
+﻿#ifndef BENCHMARK_H
+#define BENCHMARK_H
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include "Graph.h"
+#include "GraphGenerators.h"
+#include "GraphArena.h"
+#include "PerfCounters.h"
+using namespace std;
+
+//замеры производительности на синтетических графах: для каждого вида графа и размера от 10^3 рёбер
+//до заданного предела граф генерируется, записывается в файл и проходит через все алгоритмы Graph;
+//время каждого шага пишется в JSON, чтобы сравнивать кривые масштабирования между версиями;
+//со сборкой GRAPH_PERF_COUNTERS в JSON добавляются счётчики алгоритмов за каждый граф;
+//построение через addVertex/addEdge мерится дважды - в куче и на GraphArena (с памятью арены)
+class GraphBenchmark {
+public:
+    static constexpr int FLOYD_WARSHALL_MAX_VERTICES = 4096; //больше - V^2 памяти и V^3 времени
+    static constexpr int DIJKSTRA_QUERIES = 8;
+    static constexpr int BELOW_N_MAX_VERTICES = 4096;  //больше - V поисков Дейкстры по всему графу
+    static constexpr int NEGATIVE_WEIGHT_SHIFT = 100;  //разброс потенциалов для графа с отрицательными весами
+
+    struct Timing {
+        string name;
+        double milliseconds;
+        int runs;
+    };
+
+    struct Case {
+        string kind;
+        size_t targetEdges;
+        int numVertices;
+        size_t numEdges;
+        bool directed;
+        vector<Timing> timings;
+        perf::Snapshot counters;                 //прирост счётчиков за замеры этого графа
+        size_t arenaBytesHeld = 0;               //память арены после построения графа
+        size_t arenaBytesUsed = 0;
+    };
+
+private:
+    size_t maxEdges;
+    string workFile;                             //временный файл сгенерированного графа
+    vector<Case> cases;
+
+    template <class F>
+    static void measure(Case& result, const string& name, int runs, F body) {
+        auto start = chrono::steady_clock::now();
+        for (int run = 0; run < runs; ++run) {
+            body(run);
+        }
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        result.timings.push_back({ name, elapsed.count(), runs });
+    }
+
+    //построение графа через addVertex/addEdge и его разрушение: в куче (resource == nullptr) и на арене
+    static void measureBuild(Case& result, const gen::GeneratedGraph& generated, GraphArena* arena) {
+        //addEdge сообщает о повторах в консоль, поэтому повторяющиеся рёбра отбрасываются заранее
+        vector<gen::GeneratedEdge> edges = generated.edges;
+        auto key = [&](const gen::GeneratedEdge& edge) {
+            bool swap = !generated.directed && edge.to < edge.from;
+            return make_tuple(swap ? edge.to : edge.from, swap ? edge.from : edge.to, edge.weight);
+        };
+        sort(edges.begin(), edges.end(), [&](const gen::GeneratedEdge& a, const gen::GeneratedEdge& b) { return key(a) < key(b); });
+        edges.erase(unique(edges.begin(), edges.end(),
+            [&](const gen::GeneratedEdge& a, const gen::GeneratedEdge& b) { return key(a) == key(b); }), edges.end());
+        vector<string> vertexNames(generated.numVertices);
+        for (int v = 0; v < generated.numVertices; ++v) {
+            vertexNames[v] = "v" + to_string(v);
+        }
+
+        string suffix = arena ? "-arena" : "";
+        pmr::memory_resource* resource = arena ? (pmr::memory_resource*)arena : pmr::get_default_resource();
+        unique_ptr<Graph> graph;
+        measure(result, "build" + suffix, 1, [&](int) {
+            graph = make_unique<Graph>(generated.directed, resource);
+            for (const string& name : vertexNames) {
+                graph->addVertex(name);
+            }
+            for (const gen::GeneratedEdge& edge : edges) {
+                graph->addEdge(vertexNames[edge.from], vertexNames[edge.to], edge.weight);
+            }
+        });
+        if (arena) {
+            result.arenaBytesHeld = arena->getBytesHeld();
+            result.arenaBytesUsed = arena->getBytesUsed();
+        }
+        measure(result, "teardown" + suffix, 1, [&](int) {
+            graph.reset();
+            if (arena) {
+                arena->release();
+            }
+        });
+    }
+
+    Case runCase(const string& kind, size_t targetEdges) {
+        gen::GeneratedGraph generated = gen::bySize(kind, targetEdges, targetEdges * 31 + kind.size());
+        generated.writeEdgeList(workFile);
+
+        Case result;
+        result.kind = kind;
+        result.targetEdges = targetEdges;
+        result.numVertices = generated.numVertices;
+        result.numEdges = generated.edges.size();
+        result.directed = generated.directed;
+        string source = "v" + to_string(generated.source);
+        string sink = "v" + to_string(generated.sink);
+
+        perf::Snapshot before = perf::snapshot();
+        unique_ptr<Graph> graph;
+        measure(result, "load", 1, [&](int) { graph = make_unique<Graph>(workFile); });
+        measure(result, "save", 1, [&](int) { graph->saveToFile(workFile); });
+        measureBuild(result, generated, nullptr);
+        GraphArena arena;
+        measureBuild(result, generated, &arena);
+
+        //запросы идут мимо кэша путей Graph, чтобы мерить сам алгоритм
+        gen::Random random(targetEdges);
+        measure(result, "dijkstra", DIJKSTRA_QUERIES, [&](int run) {
+            string from = run == 0 ? source : "v" + to_string(random.below(generated.numVertices));
+            string to = run == 0 ? sink : "v" + to_string(random.below(generated.numVertices));
+            algo::findShortestPathDijkstra(*graph, from, to);
+        });
+        if (!graph->isDirected()) {
+            measure(result, "minimum-spanning-tree", 1, [&](int) { graph->findMinimumSpanningTree(); });
+        }
+        if (graph->getNumVertices() <= FLOYD_WARSHALL_MAX_VERTICES) {
+            measure(result, "floyd-warshall", 1, [&](int) { AllPairsShortestPaths paths(*graph); });
+        }
+        if (graph->findVertex(source) != -1 && graph->findVertex(sink) != -1) {
+            measure(result, "max-flow", 1, [&](int) { graph->fordFulkerson(source, sink); });
+        }
+        if (graph->isDirected()) {
+            measure(result, "reverse", 1, [&](int) { graph->reverseGraph(); });
+        }
+        measure(result, "components", 1, [&](int) { graph->countConnectedComponents(); });
+
+        //на положительных весах Беллман-Форд остановился бы после первого прохода,
+        //поэтому он и поиск вершин с путями не длиннее N (перевзвешивание по Джонсону) мерятся
+        //на ориентированной копии графа с отрицательными весами
+        gen::withNegativeWeights(generated, NEGATIVE_WEIGHT_SHIFT, targetEdges * 17 + kind.size()).writeEdgeList(workFile);
+        graph = make_unique<Graph>(workFile);
+        measure(result, "bellman-ford", 1, [&](int) {
+            vector<int> potential;
+            algo::findJohnsonPotentials(*graph, potential);
+        });
+        if (graph->getNumVertices() <= BELOW_N_MAX_VERTICES) {
+            measure(result, "paths-below-n", 1, [&](int) { graph->getVerticesWithPathsBelowN(INT_MAX); });
+        }
+
+        result.counters = perf::snapshot();
+        for (int c = 0; c < perf::COUNTER_COUNT; ++c) {
+            result.counters.counters[c] -= before.counters[c];
+        }
+        return result;
+    }
+
+public:
+    explicit GraphBenchmark(size_t maxEdges = 10000000, const string& workFile = "benchmark_graph.txt")
+        : maxEdges(maxEdges), workFile(workFile) {}
+
+    //все виды графов на размерах 10^3, 10^4, ... рёбер, не больше maxEdges
+    void run() {
+        const char* kinds[] = { "erdos-renyi", "rmat", "grid", "layered-flow" };
+        for (size_t edges = 1000; edges <= maxEdges; edges *= 10) {
+            for (const char* kind : kinds) {
+                cout << "Замер: " << kind << ", рёбер " << edges << endl;
+                cases.push_back(runCase(kind, edges));
+            }
+        }
+        remove(workFile.c_str());
+    }
+
+    const vector<Case>& getCases() const {
+        return cases;
+    }
+
+    void writeJson(ostream& out) const {
+        out << "{\n  \"threads\": " << ThreadPool::shared().size() << ",\n  \"cases\": [";
+        for (size_t i = 0; i < cases.size(); ++i) {
+            const Case& c = cases[i];
+            out << (i ? "," : "") << "\n    {\"graph\": \"" << c.kind << "\", \"targetEdges\": " << c.targetEdges
+                << ", \"vertices\": " << c.numVertices << ", \"edges\": " << c.numEdges
+                << ", \"directed\": " << (c.directed ? "true" : "false") << ", \"timings\": {";
+            for (size_t j = 0; j < c.timings.size(); ++j) {
+                const Timing& t = c.timings[j];
+                out << (j ? ", " : "") << "\"" << t.name << "\": {\"ms\": " << t.milliseconds << ", \"runs\": " << t.runs << "}";
+            }
+            out << "}, \"arena\": {\"heldBytes\": " << c.arenaBytesHeld << ", \"usedBytes\": " << c.arenaBytesUsed << "}";
+            if (perf::ENABLED) {
+                out << ", \"counters\": {";
+                for (int k = 0; k < perf::COUNTER_COUNT; ++k) {
+                    out << (k ? ", " : "") << "\"" << perf::counterName((perf::Counter)k) << "\": " << c.counters.counters[k];
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    void writeJson(const string& filename) const {
+        ofstream out(filename);
+        if (!out) {
+            throw runtime_error("Ошибка открытия файла для записи!");
+        }
+        writeJson(out);
+        cout << "Результаты замеров записаны в " << filename << endl;
+    }
+};
+
+#endif  // BENCHMARK_H
@@ -0,0 +1,168 @@
+﻿#ifndef BIDIRECTIONAL_DIJKSTRA_H
+#define BIDIRECTIONAL_DIJKSTRA_H
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include <limits>
+#include <type_traits>
+#include "GraphResults.h"
+#include "PerfCounters.h"
+using namespace std;
+
+//двунаправленный алгоритм Дейкстры для запросов между парой вершин
+//прямой поиск идёт от source по графу, обратный - от target по обратному графу (входящим рёбрам);
+//поиск заканчивается, когда сумма минимумов двух куч не меньше лучшего найденного пути через встречу
+//буферы живут между запросами (поколения, как в DijkstraEngine); один объект - один поток, local() - объект потока
+//DistanceT - тип расстояний (тип веса рёбер графа); суммы двух расстояний int считаются в long long
+template <class DistanceT = int>
+class BasicBidirectionalDijkstra {
+public:
+    static constexpr DistanceT UNREACHED = numeric_limits<DistanceT>::max();
+
+private:
+    using SumT = conditional_t<is_same_v<DistanceT, int>, long long, DistanceT>;
+
+    //состояние одного направления поиска
+    struct Side {
+        vector<DistanceT> distance;
+        vector<int> predecessor;                 //для обратного поиска - следующая вершина к target
+        vector<unsigned> stamp;
+        vector<pair<DistanceT, int>> heap;
+
+        bool isReached(int v, unsigned generation) const {
+            return stamp[v] == generation;
+        }
+        void push(DistanceT dist, int v) {
+            PERF_COUNT(HeapPushes, 1);
+            heap.emplace_back(dist, v);
+            push_heap(heap.begin(), heap.end(), greater<>());
+        }
+        //минимальное расстояние в куче без устаревших записей или UNREACHED, если куча пуста
+        DistanceT topDistance() {
+            while (!heap.empty() && heap.front().first > distance[heap.front().second]) {
+                PERF_COUNT(StalePops, 1);
+                pop_heap(heap.begin(), heap.end(), greater<>());
+                heap.pop_back();
+            }
+            return heap.empty() ? UNREACHED : heap.front().first;
+        }
+    };
+
+    Side forward;
+    Side backward;
+    unsigned generation = 0;
+    int settledCount = 0;
+
+    void prepare(int numVertices) {
+        for (Side* side : { &forward, &backward }) {
+            if ((int)side->stamp.size() < numVertices) {
+                side->distance.resize(numVertices);
+                side->predecessor.resize(numVertices);
+                side->stamp.resize(numVertices, 0);
+            }
+            side->heap.clear();
+        }
+        if (++generation == 0) {
+            fill(forward.stamp.begin(), forward.stamp.end(), 0);
+            fill(backward.stamp.begin(), backward.stamp.end(), 0);
+            generation = 1;
+        }
+        settledCount = 0;
+    }
+
+    //извлекает вершину из кучи стороны side и релаксирует её рёбра в graph; обновляет лучший путь через встречу
+    template <class G>
+    void step(const G& graph, Side& side, const Side& other, SumT& best, int& meet) {
+        pop_heap(side.heap.begin(), side.heap.end(), greater<>());
+        int u = side.heap.back().second;
+        side.heap.pop_back();
+        ++settledCount;
+        PERF_COUNT(SettledVertices, 1);
+        PERF_COUNT(RelaxedEdges, graph.neighbors(u).size());
+
+        for (const auto& edge : graph.neighbors(u)) {
+            int v = edge.to;
+            DistanceT newDist = side.distance[u] + edge.weight;
+            if (!side.isReached(v, generation) || newDist < side.distance[v]) {
+                side.stamp[v] = generation;
+                side.distance[v] = newDist;
+                side.predecessor[v] = u;
+                side.push(newDist, v);
+                if (other.isReached(v, generation) && (SumT)newDist + other.distance[v] < best) {
+                    best = (SumT)newDist + other.distance[v];
+                    meet = v;
+                }
+            }
+        }
+    }
+
+public:
+    static BasicBidirectionalDijkstra& local() {
+        static thread_local BasicBidirectionalDijkstra engine;
+        return engine;
+    }
+
+    //кратчайший путь source -> target; reverseGraph - входящие рёбра graph (edge.to - начало ребра)
+    //веса рёбер должны быть неотрицательными, как и для обычного алгоритма Дейкстры
+    template <class G, class R>
+    BasicPathResult<DistanceT> findPath(const G& graph, const R& reverseGraph, int source, int target) {
+        prepare(graph.getNumVertices());
+        BasicPathResult<DistanceT> result;
+        forward.stamp[source] = generation;
+        forward.distance[source] = 0;
+        forward.predecessor[source] = -1;
+        forward.push(0, source);
+        backward.stamp[target] = generation;
+        backward.distance[target] = 0;
+        backward.predecessor[target] = -1;
+        backward.push(0, target);
+
+        SumT best = numeric_limits<SumT>::max();
+        int meet = -1;
+        if (source == target) {
+            best = 0;
+            meet = source;
+        }
+
+        while (true) {
+            DistanceT forwardTop = forward.topDistance();
+            DistanceT backwardTop = backward.topDistance();
+            if (forwardTop == UNREACHED || backwardTop == UNREACHED
+                || (SumT)forwardTop + backwardTop >= best) {
+                break;
+            }
+            //расширяем сторону с меньшей кучей, чтобы фронты росли равномерно
+            if (forward.heap.size() <= backward.heap.size()) {
+                step(graph, forward, backward, best, meet);
+            }
+            else {
+                step(reverseGraph, backward, forward, best, meet);
+            }
+        }
+
+        if (meet == -1) {
+            return result;
+        }
+        result.found = true;
+        result.distance = (DistanceT)best;
+        for (int current = meet; current != -1; current = forward.predecessor[current]) {
+            result.vertices.push_back(current);
+        }
+        reverse(result.vertices.begin(), result.vertices.end());
+        for (int current = backward.predecessor[meet]; current != -1; current = backward.predecessor[current]) {
+            result.vertices.push_back(current);
+        }
+        return result;
+    }
+
+    //сколько вершин извлечено из куч обоих направлений в последнем запросе
+    int getSettledCount() const {
+        return settledCount;
+    }
+};
+
+using BidirectionalDijkstra = BasicBidirectionalDijkstra<int>;
+
+#endif  // BIDIRECTIONAL_DIJKSTRA_H
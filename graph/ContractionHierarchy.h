@@ -0,0 +1,431 @@
+﻿#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+#include <vector>
+#include <queue>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include <string>
+#include "GraphResults.h"
+#include "MappedFile.h"
+using namespace std;
+
+//иерархия сжатий (Contraction Hierarchies) для быстрых запросов кратчайшего пути на неизменяемом графе
+//вершины сжимаются по очереди (порядок - ранг), при сжатии v путь u -> v -> x заменяется ярлыком u -> x,
+//если поиск свидетеля не нашёл другого пути не длиннее; запрос - двунаправленный Дейкстра только вверх по рангу
+//рёбра хранятся в двух CSR: up - рёбра v -> x с rank[x] > rank[v] у вершины v,
+//down - рёбра u -> v с rank[u] > rank[v] у вершины v (в обратном направлении, target - начало ребра)
+//у ярлыка middle - сжатая вершина, через которую он проходит, у исходного ребра middle == -1
+class ContractionHierarchy {
+public:
+    //версия бинарного формата
+    static constexpr uint32_t BINARY_VERSION = 1;
+
+private:
+    static constexpr int WITNESS_SETTLE_LIMIT = 500; //поиск свидетеля сдаётся после стольких вершин
+
+    struct BinaryHeader {
+        char magic[8];                           //"GRAPHCH\0"
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t numVertices;
+        uint64_t numUpArcs;
+        uint64_t numDownArcs;
+    };
+
+    //ребро динамического графа во время сжатия
+    struct Arc {
+        int to;
+        int weight;
+        int middle;
+    };
+
+    //рёбра одного направления в формате CSR
+    struct ArcArrays {
+        vector<int> offsets;
+        vector<int> targets;
+        vector<int> weights;
+        vector<int> middles;
+
+        void build(const vector<vector<Arc>>& lists) {
+            offsets.assign(lists.size() + 1, 0);
+            for (size_t v = 0; v < lists.size(); ++v) {
+                offsets[v + 1] = offsets[v] + (int)lists[v].size();
+            }
+            targets.clear();
+            weights.clear();
+            middles.clear();
+            for (const auto& list : lists) {
+                for (const Arc& arc : list) {
+                    targets.push_back(arc.to);
+                    weights.push_back(arc.weight);
+                    middles.push_back(arc.middle);
+                }
+            }
+        }
+    };
+
+    //буферы поиска, общие для запросов одного потока
+    struct SearchBuffers {
+        vector<int> distance;
+        vector<int> predecessor;
+        vector<unsigned> stamp;
+        unsigned generation = 0;
+        vector<pair<int, int>> heap;
+
+        void prepare(int numVertices) {
+            if ((int)stamp.size() < numVertices) {
+                distance.resize(numVertices);
+                predecessor.resize(numVertices);
+                stamp.resize(numVertices, 0);
+            }
+            if (++generation == 0) {
+                fill(stamp.begin(), stamp.end(), 0);
+                generation = 1;
+            }
+            heap.clear();
+        }
+        bool isReached(int v) const {
+            return stamp[v] == generation;
+        }
+        //true, если расстояние улучшилось
+        bool relax(int v, int dist, int from) {
+            if (isReached(v) && distance[v] <= dist) {
+                return false;
+            }
+            stamp[v] = generation;
+            distance[v] = dist;
+            predecessor[v] = from;
+            heap.emplace_back(dist, v);
+            push_heap(heap.begin(), heap.end(), greater<>());
+            return true;
+        }
+        pair<int, int> pop() {
+            pop_heap(heap.begin(), heap.end(), greater<>());
+            pair<int, int> top = heap.back();
+            heap.pop_back();
+            return top;
+        }
+    };
+
+    int numVertices = 0;
+    vector<int> rank;                            //порядок сжатия вершины
+    ArcArrays up;
+    ArcArrays down;
+
+    //добавляет ребро u -> x в динамический граф, из параллельных рёбер остаётся самое лёгкое
+    static void addArc(vector<vector<Arc>>& out, vector<vector<Arc>>& in, int u, int x, int weight, int middle) {
+        for (Arc& arc : out[u]) {
+            if (arc.to == x) {
+                if (weight < arc.weight) {
+                    arc.weight = weight;
+                    arc.middle = middle;
+                    for (Arc& back : in[x]) {
+                        if (back.to == u) {
+                            back.weight = weight;
+                            back.middle = middle;
+                            break;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        out[u].push_back({ x, weight, middle });
+        in[x].push_back({ u, weight, middle });
+    }
+
+    //ярлыки, нужные при сжатии v: для каждого входящего u поиск свидетеля от u в обход v
+    //onShortcut(u, x, weight) вызывается для каждой пары без свидетеля
+    template <class OnShortcut>
+    static void findShortcuts(const vector<vector<Arc>>& out, const vector<vector<Arc>>& in, int v,
+        SearchBuffers& search, int numVertices, OnShortcut onShortcut) {
+        int maxOut = 0;
+        for (const Arc& arc : out[v]) {
+            maxOut = max(maxOut, arc.weight);
+        }
+        for (const Arc& incoming : in[v]) {
+            int u = incoming.to;
+            long long limit = (long long)incoming.weight + maxOut;
+            search.prepare(numVertices);
+            search.relax(u, 0, -1);
+            int settled = 0;
+            while (!search.heap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+                pair<int, int> top = search.pop();
+                if (top.first > search.distance[top.second]) continue;
+                if (top.first > limit) break;
+                ++settled;
+                for (const Arc& arc : out[top.second]) {
+                    if (arc.to != v) {
+                        search.relax(arc.to, top.first + arc.weight, top.second);
+                    }
+                }
+            }
+            for (const Arc& outgoing : out[v]) {
+                int x = outgoing.to;
+                if (x == u) continue;
+                int viaV = incoming.weight + outgoing.weight;
+                if (!search.isReached(x) || search.distance[x] > viaV) {
+                    onShortcut(u, x, viaV);
+                }
+            }
+        }
+    }
+
+    //ищет ребро a -> b иерархии (a и b соседние по рангу в ярлыке) и возвращает его middle
+    int findMiddle(int a, int b) const {
+        if (rank[a] < rank[b]) {
+            for (int i = up.offsets[a]; i < up.offsets[a + 1]; ++i) {
+                if (up.targets[i] == b) return up.middles[i];
+            }
+        }
+        else {
+            for (int i = down.offsets[b]; i < down.offsets[b + 1]; ++i) {
+                if (down.targets[i] == a) return down.middles[i];
+            }
+        }
+        throw runtime_error("Иерархия сжатий повреждена: нет ребра для распаковки ярлыка");
+    }
+
+    //добавляет к пути вершины ребра иерархии a -> b без a, раскрывая ярлыки
+    void unpackArc(int a, int b, vector<int>& path) const {
+        vector<pair<int, int>> stack = { { a, b } };
+        while (!stack.empty()) {
+            pair<int, int> arc = stack.back();
+            stack.pop_back();
+            int middle = findMiddle(arc.first, arc.second);
+            if (middle == -1) {
+                path.push_back(arc.second);
+            }
+            else {
+                stack.push_back({ middle, arc.second });
+                stack.push_back({ arc.first, middle });
+            }
+        }
+    }
+
+    ContractionHierarchy() = default;
+
+public:
+    //предобработка графа (веса рёбер неотрицательные): порядок сжатия по разности рёбер
+    //(ярлыки с двойным весом минус удаляемые рёбра) плюс число уже сжатых соседей, приоритеты уточняются лениво
+    template <class G>
+    explicit ContractionHierarchy(const G& graph) : numVertices(graph.getNumVertices()) {
+        vector<vector<Arc>> out(numVertices), in(numVertices);
+        for (int u = 0; u < numVertices; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                if (edge.weight < 0) {
+                    throw runtime_error("Иерархия сжатий требует неотрицательных весов рёбер!");
+                }
+                if (edge.to != u) {
+                    addArc(out, in, u, edge.to, edge.weight, -1);
+                }
+            }
+        }
+
+        SearchBuffers search;
+        vector<int> contractedNeighbors(numVertices, 0);
+        auto priority = [&](int v) {
+            int shortcuts = 0;
+            findShortcuts(out, in, v, search, numVertices, [&](int, int, int) { ++shortcuts; });
+            return 2 * shortcuts - (int)(in[v].size() + out[v].size()) + contractedNeighbors[v];
+        };
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+        for (int v = 0; v < numVertices; ++v) {
+            order.push({ priority(v), v });
+        }
+
+        rank.assign(numVertices, -1);
+        vector<vector<Arc>> upLists(numVertices), downLists(numVertices);
+        int nextRank = 0;
+        while (!order.empty()) {
+            int v = order.top().second;
+            order.pop();
+            if (rank[v] != -1) continue;
+            //ленивое обновление: если приоритет вырос и уже не минимальный, откладываем вершину
+            int current = priority(v);
+            if (!order.empty() && current > order.top().first) {
+                order.push({ current, v });
+                continue;
+            }
+
+            vector<WeightedEdge> shortcuts;
+            findShortcuts(out, in, v, search, numVertices, [&](int u, int x, int weight) {
+                shortcuts.push_back({ u, x, weight });
+            });
+            rank[v] = nextRank++;
+            //оставшиеся рёбра v ведут к вершинам с большим рангом и становятся рёбрами иерархии
+            upLists[v] = move(out[v]);
+            downLists[v] = move(in[v]);
+            out[v].clear();
+            in[v].clear();
+            for (const Arc& arc : upLists[v]) {
+                auto& list = in[arc.to];
+                list.erase(remove_if(list.begin(), list.end(), [v](const Arc& back) { return back.to == v; }), list.end());
+                ++contractedNeighbors[arc.to];
+            }
+            for (const Arc& arc : downLists[v]) {
+                auto& list = out[arc.to];
+                list.erase(remove_if(list.begin(), list.end(), [v](const Arc& next) { return next.to == v; }), list.end());
+                ++contractedNeighbors[arc.to];
+            }
+            for (const WeightedEdge& shortcut : shortcuts) {
+                addArc(out, in, shortcut.from, shortcut.to, shortcut.weight, v);
+            }
+        }
+
+        up.build(upLists);
+        down.build(downLists);
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+    //кол-во рёбер иерархии (исходные рёбра и ярлыки)
+    int getNumArcs() const {
+        return (int)(up.targets.size() + down.targets.size());
+    }
+
+    //кратчайший путь source -> target с раскрытием ярлыков до исходных вершин
+    PathResult findPath(int source, int target) const {
+        static thread_local SearchBuffers forward, backward;
+        forward.prepare(numVertices);
+        backward.prepare(numVertices);
+        forward.relax(source, 0, -1);
+        backward.relax(target, 0, -1);
+
+        long long best = LLONG_MAX;
+        int meet = -1;
+        auto meetAt = [&](int v) {
+            if (forward.isReached(v) && backward.isReached(v) && (long long)forward.distance[v] + backward.distance[v] < best) {
+                best = (long long)forward.distance[v] + backward.distance[v];
+                meet = v;
+            }
+        };
+        meetAt(source);
+
+        //каждая сторона идёт только вверх по рангу и останавливается, когда минимум её кучи не меньше best
+        while (true) {
+            bool forwardActive = !forward.heap.empty() && forward.heap.front().first < best;
+            bool backwardActive = !backward.heap.empty() && backward.heap.front().first < best;
+            if (!forwardActive && !backwardActive) break;
+            bool useForward = forwardActive && (!backwardActive || forward.heap.front().first <= backward.heap.front().first);
+            SearchBuffers& side = useForward ? forward : backward;
+            const ArcArrays& arcs = useForward ? up : down;
+
+            pair<int, int> top = side.pop();
+            int u = top.second;
+            if (top.first > side.distance[u]) continue;
+            for (int i = arcs.offsets[u]; i < arcs.offsets[u + 1]; ++i) {
+                if (side.relax(arcs.targets[i], top.first + arcs.weights[i], u)) {
+                    meetAt(arcs.targets[i]);
+                }
+            }
+        }
+
+        PathResult result;
+        if (meet == -1) {
+            return result;
+        }
+        result.found = true;
+        result.distance = (int)best;
+        vector<int> upChain; //вершины от meet вниз до source
+        for (int current = meet; current != -1; current = forward.predecessor[current]) {
+            upChain.push_back(current);
+        }
+        result.vertices.push_back(source);
+        for (size_t i = upChain.size() - 1; i > 0; --i) {
+            unpackArc(upChain[i], upChain[i - 1], result.vertices);
+        }
+        for (int current = meet; backward.predecessor[current] != -1; current = backward.predecessor[current]) {
+            unpackArc(current, backward.predecessor[current], result.vertices);
+        }
+        return result;
+    }
+
+    //сохраняет иерархию в бинарный файл, чтобы не повторять предобработку
+    void saveToBinaryFile(const string& filename) const {
+        ofstream outFile(filename, ios::binary);
+        if (!outFile) {
+            throw runtime_error("Ошибка открытия файла для записи!");
+        }
+        BinaryHeader header = {};
+        memcpy(header.magic, "GRAPHCH", 8);
+        header.version = BINARY_VERSION;
+        header.numVertices = numVertices;
+        header.numUpArcs = up.targets.size();
+        header.numDownArcs = down.targets.size();
+        outFile.write((const char*)&header, sizeof(header));
+        auto write = [&](const vector<int>& data) {
+            outFile.write((const char*)data.data(), data.size() * sizeof(int));
+        };
+        write(rank);
+        for (const ArcArrays* arcs : { &up, &down }) {
+            write(arcs->offsets);
+            write(arcs->targets);
+            write(arcs->weights);
+            write(arcs->middles);
+        }
+        if (!outFile) {
+            throw runtime_error("Ошибка записи иерархии сжатий в файл " + filename);
+        }
+    }
+
+    static ContractionHierarchy loadFromBinaryFile(const string& filename) {
+        MappedFile file(filename);
+        BinaryHeader header;
+        if (file.size() < sizeof(header) || memcmp(file.data(), "GRAPHCH", 8) != 0) {
+            throw runtime_error("Файл " + filename + " не является иерархией сжатий!");
+        }
+        memcpy(&header, file.data(), sizeof(header));
+        if (header.version != BINARY_VERSION) {
+            throw runtime_error("Неподдерживаемая версия иерархии сжатий: " + to_string(header.version));
+        }
+        if (header.numVertices > (uint64_t)INT_MAX || header.numUpArcs > (uint64_t)INT_MAX || header.numDownArcs > (uint64_t)INT_MAX
+            || file.size() != sizeof(header) + sizeof(int) * (3 * header.numVertices + 2
+                + 3 * (header.numUpArcs + header.numDownArcs))) {
+            throw runtime_error("Иерархия сжатий " + filename + " повреждена!");
+        }
+
+        ContractionHierarchy hierarchy;
+        hierarchy.numVertices = (int)header.numVertices;
+        const char* pos = file.data() + sizeof(header);
+        auto read = [&](vector<int>& data, uint64_t count) {
+            data.assign((const int*)pos, (const int*)pos + count);
+            pos += count * sizeof(int);
+        };
+        read(hierarchy.rank, header.numVertices);
+        uint64_t counts[2] = { header.numUpArcs, header.numDownArcs };
+        ArcArrays* parts[2] = { &hierarchy.up, &hierarchy.down };
+        for (int part = 0; part < 2; ++part) {
+            read(parts[part]->offsets, header.numVertices + 1);
+            read(parts[part]->targets, counts[part]);
+            read(parts[part]->weights, counts[part]);
+            read(parts[part]->middles, counts[part]);
+            const vector<int>& offsets = parts[part]->offsets;
+            if (offsets[0] != 0 || (uint64_t)offsets[hierarchy.numVertices] != counts[part]) {
+                throw runtime_error("Иерархия сжатий " + filename + " повреждена!");
+            }
+            for (int v = 0; v < hierarchy.numVertices; ++v) {
+                if (offsets[v] > offsets[v + 1]) {
+                    throw runtime_error("Иерархия сжатий " + filename + " повреждена!");
+                }
+            }
+            for (uint64_t i = 0; i < counts[part]; ++i) {
+                int target = parts[part]->targets[i];
+                int middle = parts[part]->middles[i];
+                if (target < 0 || target >= hierarchy.numVertices || middle < -1 || middle >= hierarchy.numVertices) {
+                    throw runtime_error("Иерархия сжатий " + filename + " повреждена!");
+                }
+            }
+        }
+        return hierarchy;
+    }
+};
+
+#endif  // CONTRACTION_HIERARCHY_H
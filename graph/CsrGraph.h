@@ -0,0 +1,339 @@
+﻿#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+#include <vector>
+#include <string>
+#include <memory>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "Edge.h"
+#include "Graph.h"
+#include "VertexNames.h"
+#include "MappedFile.h"
+#include "GraphAlgorithms.h"
+#include "Transpose.h"
+using namespace std;
+
+//неизменяемый снимок графа в формате CSR (compressed sparse row)
+//рёбра вершины u лежат подряд в targets/weights на отрезке [offsets[u], offsets[u + 1])
+//массивы принадлежат либо самому снимку, либо отображённому в память бинарному файлу
+class CsrGraph {
+public:
+    //версия бинарного формата, меняется при любом несовместимом изменении раскладки
+    static constexpr uint32_t BINARY_VERSION = 1;
+
+private:
+    //заголовок бинарного файла; все секции выровнены на 8 байт, позиции считаются от начала файла
+    struct BinaryHeader {
+        char magic[8];                           //"GRAPHCSR"
+        uint32_t version;                        //BINARY_VERSION
+        uint32_t flags;                          //бит 0 - ориентированный граф
+        uint64_t numVertices;
+        uint64_t numArcs;                        //записей в списках смежности
+        uint64_t nameBytes;                      //суммарная длина имён
+        uint64_t slotCount;                      //размер хэш-таблицы имён
+        uint64_t offsetsPos;                     //int32[numVertices + 1]
+        uint64_t targetsPos;                     //int32[numArcs]
+        uint64_t weightsPos;                     //int32[numArcs]
+        uint64_t nameOffsetsPos;                 //uint64[numVertices + 1]
+        uint64_t slotsPos;                       //int32[slotCount]
+        uint64_t nameDataPos;                    //char[nameBytes]
+        uint64_t fileSize;
+    };
+
+    //массивы снимка, построенного в памяти
+    struct OwnedArrays {
+        vector<int> offsets;
+        vector<int> targets;
+        vector<int> weights;
+        vector<uint64_t> nameOffsets;
+        vector<int> slots;
+        string nameData;
+    };
+
+    //массивы обращённого снимка; имена остаются в хранилище исходного снимка
+    struct TransposedArrays {
+        vector<int> offsets;
+        vector<int> targets;
+        vector<int> weights;
+        shared_ptr<const void> base;
+    };
+
+    int numVertices = 0;                         //кол-во вершин
+    bool directed = false;                       //флаг ориентированного/неориетированного графа
+    const int* offsets = nullptr;                //начало рёбер каждой вершины, размер numVertices + 1
+    const int* targets = nullptr;                //конечные вершины рёбер
+    const int* weights = nullptr;                //веса рёбер
+    NameTableView names;                         //имена вершин
+    shared_ptr<const void> storage;              //владелец массивов (OwnedArrays или MappedFile)
+
+    CsrGraph() = default;
+
+    static uint64_t align8(uint64_t pos) {
+        return (pos + 7) & ~(uint64_t)7;
+    }
+
+public:
+    //строит снимок по текущему состоянию графа за O(V + E)
+    //удалённые, но ещё не уплотнённые вершины Graph в снимок не попадают: остальные нумеруются подряд
+    //в прежнем порядке (как после Graph::compact()), поэтому компоненты и остовный лес совпадают с Graph
+    explicit CsrGraph(const Graph& graph) : directed(graph.isDirected()) {
+        int graphVertices = graph.getNumVertices();
+        vector<int> remap(graphVertices);
+        numVertices = 0;
+        for (int u = 0; u < graphVertices; ++u) {
+            remap[u] = graph.isRemoved(u) ? -1 : numVertices++;
+        }
+        bool compacted = numVertices != graphVertices;
+
+        auto arrays = make_shared<OwnedArrays>();
+        arrays->offsets.assign(numVertices + 1, 0);
+        for (int u = 0; u < graphVertices; ++u) {
+            if (remap[u] != -1) {
+                arrays->offsets[remap[u] + 1] = arrays->offsets[remap[u]] + (int)graph.neighbors(u).size();
+            }
+        }
+
+        arrays->targets.resize(arrays->offsets[numVertices]);
+        arrays->weights.resize(arrays->offsets[numVertices]);
+        for (int u = 0; u < graphVertices; ++u) {
+            if (remap[u] == -1) {
+                continue;
+            }
+            int pos = arrays->offsets[remap[u]];
+            for (const Edge& edge : graph.neighbors(u)) {
+                arrays->targets[pos] = remap[edge.to];
+                arrays->weights[pos] = edge.weight;
+                ++pos;
+            }
+        }
+
+        //имена раскладываются подряд; без удалённых вершин хэш-таблица переносится как есть (формат совпадает),
+        //иначе строится заново по новым номерам тем же линейным пробированием
+        const VertexNames& graphNames = graph.getVertexNames();
+        arrays->nameOffsets.assign(numVertices + 1, 0);
+        for (int u = 0; u < graphVertices; ++u) {
+            if (remap[u] != -1) {
+                arrays->nameOffsets[remap[u] + 1] = arrays->nameOffsets[remap[u]] + graphNames[u].size();
+            }
+        }
+        arrays->nameData.reserve(arrays->nameOffsets[numVertices]);
+        for (int u = 0; u < graphVertices; ++u) {
+            if (remap[u] != -1) {
+                arrays->nameData.append(graphNames[u]);
+            }
+        }
+        if (!compacted) {
+            arrays->slots = graphNames.getSlots();
+        }
+        else {
+            size_t size = 16;
+            while (size < (size_t)numVertices * 2) {
+                size *= 2;
+            }
+            arrays->slots.assign(size, -1);
+            for (int u = 0; u < graphVertices; ++u) {
+                if (remap[u] == -1) {
+                    continue;
+                }
+                size_t slot = hashVertexName(graphNames[u]) & (size - 1);
+                while (arrays->slots[slot] != -1) {
+                    slot = (slot + 1) & (size - 1);
+                }
+                arrays->slots[slot] = remap[u];
+            }
+        }
+
+        offsets = arrays->offsets.data();
+        targets = arrays->targets.data();
+        weights = arrays->weights.data();
+        names = NameTableView(arrays->nameOffsets.data(), arrays->nameData.data(),
+            arrays->slots.data(), arrays->slots.size(), numVertices);
+        storage = arrays;
+    }
+
+    //загружает снимок из бинарного файла без копирования: массивы указывают прямо в отображённый файл
+    static CsrGraph loadFromBinaryFile(const string& filename) {
+        auto file = make_shared<MappedFile>(filename);
+        if (file->size() < sizeof(BinaryHeader)) {
+            throw runtime_error("Файл " + filename + " не является бинарным снимком графа!");
+        }
+
+        BinaryHeader header;
+        memcpy(&header, file->data(), sizeof(header));
+        if (memcmp(header.magic, "GRAPHCSR", 8) != 0) {
+            throw runtime_error("Файл " + filename + " не является бинарным снимком графа!");
+        }
+        if (header.version != BINARY_VERSION) {
+            throw runtime_error("Неподдерживаемая версия бинарного снимка: " + to_string(header.version));
+        }
+
+        //все секции должны целиком лежать внутри файла
+        auto inside = [&](uint64_t pos, uint64_t count, uint64_t size) {
+            return pos % 8 == 0 && pos <= file->size() && count <= (file->size() - pos) / size;
+        };
+        if (header.fileSize != file->size() || header.numVertices > (uint64_t)INT_MAX || header.numArcs > (uint64_t)INT_MAX
+            || !inside(header.offsetsPos, header.numVertices + 1, sizeof(int))
+            || !inside(header.targetsPos, header.numArcs, sizeof(int))
+            || !inside(header.weightsPos, header.numArcs, sizeof(int))
+            || !inside(header.nameOffsetsPos, header.numVertices + 1, sizeof(uint64_t))
+            || !inside(header.slotsPos, header.slotCount, sizeof(int))
+            || !inside(header.nameDataPos, header.nameBytes, 1)
+            || (header.slotCount & (header.slotCount - 1)) != 0) {
+            throw runtime_error("Бинарный снимок " + filename + " повреждён!");
+        }
+
+        CsrGraph graph;
+        const char* base = file->data();
+        graph.numVertices = (int)header.numVertices;
+        graph.directed = (header.flags & 1) != 0;
+        graph.offsets = (const int*)(base + header.offsetsPos);
+        graph.targets = (const int*)(base + header.targetsPos);
+        graph.weights = (const int*)(base + header.weightsPos);
+        const uint64_t* nameOffsets = (const uint64_t*)(base + header.nameOffsetsPos);
+        if (graph.offsets[0] != 0 || (uint64_t)graph.offsets[graph.numVertices] != header.numArcs
+            || nameOffsets[0] != 0 || nameOffsets[graph.numVertices] != header.nameBytes) {
+            throw runtime_error("Бинарный снимок " + filename + " повреждён!");
+        }
+        //проход O(V + E) по содержимому: смещения не убывают, концы рёбер и индексы в хэш-таблице
+        //лежат в нумерации, в хэш-таблице есть пустая ячейка (иначе поиск имени не остановится)
+        const int* slots = (const int*)(base + header.slotsPos);
+        bool valid = true;
+        for (int v = 0; v < graph.numVertices && valid; ++v) {
+            valid = graph.offsets[v] <= graph.offsets[v + 1] && nameOffsets[v] <= nameOffsets[v + 1];
+        }
+        for (uint64_t i = 0; i < header.numArcs && valid; ++i) {
+            valid = graph.targets[i] >= 0 && graph.targets[i] < graph.numVertices;
+        }
+        bool hasEmptySlot = header.slotCount == 0;
+        for (uint64_t i = 0; i < header.slotCount && valid; ++i) {
+            valid = slots[i] >= -1 && slots[i] < graph.numVertices;
+            hasEmptySlot = hasEmptySlot || slots[i] == -1;
+        }
+        if (!valid || !hasEmptySlot) {
+            throw runtime_error("Бинарный снимок " + filename + " повреждён!");
+        }
+
+        graph.names = NameTableView(nameOffsets, base + header.nameDataPos, slots, header.slotCount, graph.numVertices);
+        graph.storage = file;
+        return graph;
+    }
+
+    //сохраняет снимок в бинарный файл (текстовый формат Graph::saveToFile остаётся форматом обмена)
+    void saveToBinaryFile(const string& filename) const {
+        ofstream outFile(filename, ios::binary);
+        if (!outFile) {
+            throw runtime_error("Ошибка открытия файла для записи!");
+        }
+
+        const uint64_t* nameOffsets = getNameOffsets();
+        BinaryHeader header = {};
+        memcpy(header.magic, "GRAPHCSR", 8);
+        header.version = BINARY_VERSION;
+        header.flags = directed ? 1 : 0;
+        header.numVertices = numVertices;
+        header.numArcs = getNumArcs();
+        header.nameBytes = nameOffsets[numVertices];
+        header.slotCount = names.getSlotCount();
+        header.offsetsPos = align8(sizeof(BinaryHeader));
+        header.targetsPos = align8(header.offsetsPos + (header.numVertices + 1) * sizeof(int));
+        header.weightsPos = align8(header.targetsPos + header.numArcs * sizeof(int));
+        header.nameOffsetsPos = align8(header.weightsPos + header.numArcs * sizeof(int));
+        header.slotsPos = align8(header.nameOffsetsPos + (header.numVertices + 1) * sizeof(uint64_t));
+        header.nameDataPos = align8(header.slotsPos + header.slotCount * sizeof(int));
+        header.fileSize = header.nameDataPos + header.nameBytes;
+
+        uint64_t written = 0;
+        auto writeAt = [&](uint64_t pos, const void* data, uint64_t size) {
+            static const char zeros[8] = {};
+            outFile.write(zeros, pos - written);
+            outFile.write((const char*)data, size);
+            written = pos + size;
+        };
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.offsetsPos, offsets, (header.numVertices + 1) * sizeof(int));
+        writeAt(header.targetsPos, targets, header.numArcs * sizeof(int));
+        writeAt(header.weightsPos, weights, header.numArcs * sizeof(int));
+        writeAt(header.nameOffsetsPos, nameOffsets, (header.numVertices + 1) * sizeof(uint64_t));
+        writeAt(header.slotsPos, names.getSlots(), header.slotCount * sizeof(int));
+        writeAt(header.nameDataPos, names.getData(), header.nameBytes);
+
+        if (!outFile) {
+            throw runtime_error("Ошибка записи бинарного снимка в файл " + filename);
+        }
+        cout << "Граф успешно сохранён в бинарный файл " << filename << endl;
+    }
+
+    //обращённый снимок (ориентированный, рёбра развёрнуты) за O(V + E) сортировкой подсчётом;
+    //списки смежности новые, таблица имён общая с исходным снимком и не копируется
+    CsrGraph reversed() const {
+        TransposeBuilder transpose(*this);
+        const vector<int>& inDegree = transpose.getInDegrees();
+        auto arrays = make_shared<TransposedArrays>();
+        arrays->offsets.assign(numVertices + 1, 0);
+        for (int v = 0; v < numVertices; ++v) {
+            arrays->offsets[v + 1] = arrays->offsets[v] + inDegree[v];
+        }
+        arrays->targets.resize(getNumArcs());
+        arrays->weights.resize(getNumArcs());
+        transpose.fill(*this, [&](int v, int pos, int from, int weight) {
+            arrays->targets[arrays->offsets[v] + pos] = from;
+            arrays->weights[arrays->offsets[v] + pos] = weight;
+        });
+        arrays->base = storage;
+
+        CsrGraph graph;
+        graph.numVertices = numVertices;
+        graph.directed = true;
+        graph.offsets = arrays->offsets.data();
+        graph.targets = arrays->targets.data();
+        graph.weights = arrays->weights.data();
+        graph.names = names;
+        graph.storage = arrays;
+        return graph;
+    }
+
+    bool isDirected() const {
+        return directed;
+    }
+    int getNumVertices() const {
+        return numVertices;
+    }
+    //кол-во записей в списках смежности (в неориентированном графе каждое ребро учтено дважды)
+    int getNumArcs() const {
+        return offsets[numVertices];
+    }
+    string_view getVertexName(int index) const {
+        return names[index];
+    }
+    //индекс вершины по имени или -1, если вершины нет
+    int findVertex(const string& name) const {
+        return names.find(name);
+    }
+    EdgeRange neighbors(int u) const {
+        return EdgeRange(targets + offsets[u], weights + offsets[u], offsets[u + 1] - offsets[u]);
+    }
+
+    const int* getOffsets() const { return offsets; }
+    const int* getTargets() const { return targets; }
+    const int* getWeights() const { return weights; }
+    const uint64_t* getNameOffsets() const { return names.getOffsets(); }
+
+    //алгоритмы только для чтения, совпадают по поведению с методами Graph
+    bool hasPath(int u, int v) const {
+        return algo::hasPath(*this, u, v);
+    }
+    int countConnectedComponents() const {
+        return algo::countConnectedComponents(*this);
+    }
+    SpanningForestResult findMinimumSpanningTree() const {
+        return algo::findMinimumSpanningTree(*this);
+    }
+    //кратчайший путь алгоритмом Дейкстры; если вершины нет или путь не найден, found == false
+    PathResult findShortestPathDijkstra(const string& u, const string& v) const {
+        return algo::findShortestPathDijkstra(*this, u, v);
+    }
+};
+
+#endif  // CSR_GRAPH_H
@@ -0,0 +1,202 @@
+﻿#ifndef DIJKSTRA_ENGINE_H
+#define DIJKSTRA_ENGINE_H
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include <limits>
+#include "GraphResults.h"
+#include "PerfCounters.h"
+using namespace std;
+
+//алгоритм Дейкстры для многократных запросов к одному графу
+//массивы расстояний и предшественников живут между запросами и не очищаются целиком:
+//у каждой вершины хранится номер запроса (поколение), вершина с чужим поколением считается непосещённой
+//один объект - один поток, local() даёт отдельный объект для каждого потока; работает с любым графом, у которого есть getNumVertices() и neighbors(u)
+//DistanceT - тип расстояний (тип веса рёбер графа: int, long long, double)
+template <class DistanceT = int>
+class BasicDijkstraEngine {
+public:
+    static constexpr DistanceT UNREACHED = numeric_limits<DistanceT>::max();
+
+private:
+    vector<DistanceT> distance;                  //минимальные расстояния (действительны при stamp[v] == generation)
+    vector<int> predecessor;                     //предшественники для восстановления пути
+    vector<unsigned> stamp;                      //поколение, в котором вершина получила расстояние
+    unsigned generation = 0;                     //номер текущего запроса
+    vector<pair<DistanceT, int>> heap;           //двоичная куча (расстояние, вершина), ёмкость сохраняется
+    int settledCount = 0;                        //вершин с окончательным расстоянием в последнем запросе
+
+    //начинает новый запрос без обнуления массивов
+    void prepare(int numVertices) {
+        if ((int)stamp.size() < numVertices) {
+            distance.resize(numVertices);
+            predecessor.resize(numVertices);
+            stamp.resize(numVertices, 0);
+        }
+        if (++generation == 0) { //счётчик поколений переполнился - один раз очищаем отметки
+            fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        heap.clear();
+        settledCount = 0;
+    }
+
+    void push(DistanceT dist, int vertex) {
+        PERF_COUNT(HeapPushes, 1);
+        heap.emplace_back(dist, vertex);
+        push_heap(heap.begin(), heap.end(), greater<>());
+    }
+
+    pair<DistanceT, int> pop() {
+        pop_heap(heap.begin(), heap.end(), greater<>());
+        pair<DistanceT, int> top = heap.back();
+        heap.pop_back();
+        return top;
+    }
+
+public:
+    static BasicDijkstraEngine& local() {
+        static thread_local BasicDijkstraEngine engine;
+        return engine;
+    }
+
+    //поиск от source; onSettle(vertex, distance) вызывается для каждой вершины, расстояние до которой
+    //стало окончательным (в порядке неубывания), и может вернуть false, чтобы остановить поиск
+    template <class G, class OnSettle>
+    void searchFrom(const G& graph, int source, OnSettle onSettle) {
+        prepare(graph.getNumVertices());
+        stamp[source] = generation;
+        distance[source] = 0;
+        predecessor[source] = -1;
+        push(0, source);
+
+        while (!heap.empty()) {
+            pair<DistanceT, int> top = pop();
+            DistanceT dist = top.first;
+            int u = top.second;
+
+            //если расстояние из очереди больше текущего, пропускаем
+            if (dist > distance[u]) {
+                PERF_COUNT(StalePops, 1);
+                continue;
+            }
+            ++settledCount;
+            PERF_COUNT(SettledVertices, 1);
+            if (!onSettle(u, dist)) break;
+
+            PERF_COUNT(RelaxedEdges, graph.neighbors(u).size());
+
+            for (const auto& edge : graph.neighbors(u)) {
+                int v = edge.to;
+                DistanceT newDist = dist + edge.weight;
+                if (stamp[v] != generation || newDist < distance[v]) {
+                    stamp[v] = generation;
+                    distance[v] = newDist;
+                    predecessor[v] = u;
+                    push(newDist, v);
+                }
+            }
+        }
+    }
+
+    //кратчайший путь между двумя вершинами (индексы должны быть корректными)
+    template <class G>
+    BasicPathResult<DistanceT> findPath(const G& graph, int source, int target) {
+        //расстояние до цели окончательно, как только она извлечена из кучи; остальная часть графа не нужна
+        searchFrom(graph, source, [target](int vertex, DistanceT) { return vertex != target; });
+
+        BasicPathResult<DistanceT> result;
+        if (!isReached(target)) {
+            return result;
+        }
+        result.found = true;
+        result.distance = distance[target];
+        for (int current = target; current != -1; current = predecessor[current]) {
+            result.vertices.push_back(current);
+        }
+        reverse(result.vertices.begin(), result.vertices.end());
+        return result;
+    }
+
+    //кратчайший путь поиском A*: куча упорядочена по distance + potential(v), где potential(v) - нижняя оценка
+    //расстояния от v до target (согласованная: potential(u) <= w(u, v) + potential(v)); INT_MAX - target из v недостижима
+    template <class G, class Potential>
+    BasicPathResult<DistanceT> findPathAStar(const G& graph, int source, int target, Potential potential) {
+        prepare(graph.getNumVertices());
+        BasicPathResult<DistanceT> result;
+        int sourcePotential = potential(source);
+        if (sourcePotential == INT_MAX) {
+            return result;
+        }
+        stamp[source] = generation;
+        distance[source] = 0;
+        predecessor[source] = -1;
+        push(sourcePotential, source);
+
+        while (!heap.empty()) {
+            pair<DistanceT, int> top = pop();
+            int u = top.second;
+            if (top.first - potential(u) > distance[u]) {
+                PERF_COUNT(StalePops, 1);
+                continue;
+            }
+            ++settledCount;
+            PERF_COUNT(SettledVertices, 1);
+            if (u == target) break;
+
+            PERF_COUNT(RelaxedEdges, graph.neighbors(u).size());
+
+            for (const auto& edge : graph.neighbors(u)) {
+                int v = edge.to;
+                DistanceT newDist = distance[u] + edge.weight;
+                if (stamp[v] != generation || newDist < distance[v]) {
+                    int estimate = potential(v);
+                    if (estimate == INT_MAX) continue;
+                    stamp[v] = generation;
+                    distance[v] = newDist;
+                    predecessor[v] = u;
+                    push(newDist + estimate, v);
+                }
+            }
+        }
+
+        if (!isReached(target)) {
+            return result;
+        }
+        result.found = true;
+        result.distance = distance[target];
+        for (int current = target; current != -1; current = predecessor[current]) {
+            result.vertices.push_back(current);
+        }
+        reverse(result.vertices.begin(), result.vertices.end());
+        return result;
+    }
+
+    //кратчайшие расстояния от source до всех вершин, читаются через getDistance/getPredecessor
+    template <class G>
+    void findAllDistances(const G& graph, int source) {
+        searchFrom(graph, source, [](int, DistanceT) { return true; });
+    }
+
+    //получила ли вершина расстояние в последнем запросе
+    bool isReached(int vertex) const {
+        return stamp[vertex] == generation;
+    }
+    //расстояние из последнего запроса или UNREACHED, если вершина не достигнута
+    DistanceT getDistance(int vertex) const {
+        return isReached(vertex) ? distance[vertex] : UNREACHED;
+    }
+    int getPredecessor(int vertex) const {
+        return isReached(vertex) ? predecessor[vertex] : -1;
+    }
+    //сколько вершин извлечено из кучи с окончательным расстоянием в последнем запросе
+    int getSettledCount() const {
+        return settledCount;
+    }
+};
+
+using DijkstraEngine = BasicDijkstraEngine<int>;
+
+#endif  // DIJKSTRA_ENGINE_H
@@ -0,0 +1,80 @@
+﻿#ifndef DISJOINT_SETS_H
+#define DISJOINT_SETS_H
+#include <vector>
+#include <numeric>
+#include <utility>
+using namespace std;
+
+//система непересекающихся множеств (union-find) с объединением по размеру и сжатием путей делением пополам
+//элементы - плотные индексы 0..size()-1, новые элементы добавляются отдельными множествами
+class DisjointSets {
+private:
+    vector<int> parent;
+    vector<int> setSize;                         //размер множества (действителен для корней)
+    int sets = 0;                                //кол-во множеств
+
+public:
+    //n элементов, каждый в своём множестве
+    void reset(int n) {
+        parent.resize(n);
+        iota(parent.begin(), parent.end(), 0);
+        setSize.assign(n, 1);
+        sets = n;
+    }
+
+    //память под n элементов без перераспределений при add()
+    void reserve(int n) {
+        parent.reserve(n);
+        setSize.reserve(n);
+    }
+
+    //добавляет элемент отдельным множеством и возвращает его индекс
+    int add() {
+        int index = (int)parent.size();
+        parent.push_back(index);
+        setSize.push_back(1);
+        ++sets;
+        return index;
+    }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    //корень без сжатия путей: не меняет структуру, поэтому безопасен для параллельного чтения
+    int findRoot(int x) const {
+        while (parent[x] != x) {
+            x = parent[x];
+        }
+        return x;
+    }
+
+    //объединяет множества a и b; false, если они уже были одним множеством
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (setSize[a] < setSize[b]) {
+            swap(a, b);
+        }
+        parent[b] = a;
+        setSize[a] += setSize[b];
+        --sets;
+        return true;
+    }
+
+    int size() const {
+        return (int)parent.size();
+    }
+    int count() const {
+        return sets;
+    }
+};
+
+#endif  // DISJOINT_SETS_H
@@ -0,0 +1,88 @@
+﻿#ifndef EDGE_H
+#define EDGE_H
+#include <vector>
+#include <iterator>
+#include <cstddef>
+using namespace std;
+
+//ребро списка смежности: WeightT - тип веса, IndexT - тип номера вершины
+template <class WeightT = int, class IndexT = int>
+struct BasicEdge {
+    IndexT to;         //конечная вершина
+    WeightT weight;    //вес ребра
+    BasicEdge(IndexT to, WeightT weight) : to(to), weight(weight) {}
+};
+using Edge = BasicEdge<int, int>;
+static_assert(sizeof(Edge) == 8, "ребро с 32-битными номером и весом должно занимать 8 байт");
+
+//диапазон рёбер одной вершины в массивах CSR, при обходе выдаёт Edge по значению
+class EdgeRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Edge;
+        using difference_type = ptrdiff_t;
+        using pointer = void;
+        using reference = Edge;
+
+        iterator(const int* to, const int* weight) : to(to), weight(weight) {}
+        Edge operator*() const { return Edge(*to, *weight); }
+        iterator& operator++() { ++to; ++weight; return *this; }
+        iterator operator++(int) { iterator old = *this; ++*this; return old; }
+        bool operator==(const iterator& other) const { return to == other.to; }
+        bool operator!=(const iterator& other) const { return to != other.to; }
+
+    private:
+        const int* to;
+        const int* weight;
+    };
+
+    EdgeRange(const int* to, const int* weight, int count) : to(to), weight(weight), count(count) {}
+    iterator begin() const { return iterator(to, weight); }
+    iterator end() const { return iterator(to + count, weight + count); }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    const int* to;
+    const int* weight;
+    int count;
+};
+
+//списки смежности в формате CSR без имён вершин - вспомогательные графы внутри алгоритмов
+struct CsrAdjacency {
+    int numVertices = 0;
+    vector<int> offsets;                         //размер numVertices + 1
+    vector<int> targets;
+    vector<int> weights;
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+    EdgeRange neighbors(int u) const {
+        return EdgeRange(targets.data() + offsets[u], weights.data() + offsets[u], offsets[u + 1] - offsets[u]);
+    }
+
+    //копия списков смежности любого графа с getNumVertices() и neighbors(u)
+    template <class G>
+    static CsrAdjacency from(const G& graph) {
+        CsrAdjacency csr;
+        csr.numVertices = graph.getNumVertices();
+        csr.offsets.assign(csr.numVertices + 1, 0);
+        for (int u = 0; u < csr.numVertices; ++u) {
+            csr.offsets[u + 1] = csr.offsets[u] + (int)graph.neighbors(u).size();
+        }
+        csr.targets.reserve(csr.offsets[csr.numVertices]);
+        csr.weights.reserve(csr.offsets[csr.numVertices]);
+        for (int u = 0; u < csr.numVertices; ++u) {
+            for (const auto& edge : graph.neighbors(u)) {
+                csr.targets.push_back(edge.to);
+                csr.weights.push_back(edge.weight);
+            }
+        }
+        return csr;
+    }
+};
+
+#endif  // EDGE_H
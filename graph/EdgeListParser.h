@@ -0,0 +1,138 @@
+﻿#ifndef EDGE_LIST_PARSER_H
+#define EDGE_LIST_PARSER_H
+#include <string_view>
+#include <cstddef>
+#include <climits>
+#include <limits>
+#include <string>
+#include <charconv>
+#include <system_error>
+#include <type_traits>
+using namespace std;
+
+//разбор текстового формата графа ("Directed"/"Undirected", затем тройки "from to weight")
+//прямо из памяти, без iostream и без выделения строк
+class EdgeListParser {
+private:
+    const char* pos;
+    const char* end;
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+    }
+
+public:
+    EdgeListParser(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    //первая строка файла целиком (без символа перевода строки)
+    string_view readLine() {
+        const char* start = pos;
+        while (pos < end && *pos != '\n') {
+            ++pos;
+        }
+        string_view line(start, pos - start);
+        if (pos < end) {
+            ++pos;
+        }
+        return line;
+    }
+
+    //следующее слово, разделённое пробельными символами; false, если данные закончились
+    bool nextToken(string_view& token) {
+        while (pos < end && isSpace(*pos)) {
+            ++pos;
+        }
+        if (pos == end) {
+            return false;
+        }
+        const char* start = pos;
+        while (pos < end && !isSpace(*pos)) {
+            ++pos;
+        }
+        token = string_view(start, pos - start);
+        return true;
+    }
+
+    //целое число со знаком; false, если токен не число или не помещается в int
+    static bool parseInt(string_view token, int& value) {
+        size_t i = 0;
+        bool negative = false;
+        if (i < token.size() && (token[i] == '-' || token[i] == '+')) {
+            negative = token[i] == '-';
+            ++i;
+        }
+        if (i == token.size()) {
+            return false;
+        }
+        long long result = 0;
+        for (; i < token.size(); ++i) {
+            unsigned digit = (unsigned)(token[i] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            result = result * 10 + digit;
+            if (result > (long long)INT_MAX + 1) {
+                return false;
+            }
+        }
+        if (negative) {
+            result = -result;
+        }
+        if (result > INT_MAX || result < INT_MIN) {
+            return false;
+        }
+        value = (int)result;
+        return true;
+    }
+
+    //вес ребра типа T: целые числа со знаком любой ширины или числа с плавающей точкой
+    template <class T>
+    static bool parseNumber(string_view token, T& value) {
+        if constexpr (is_same_v<T, int>) {
+            return parseInt(token, value);
+        }
+        else if constexpr (is_integral_v<T>) {
+            size_t i = 0;
+            bool negative = false;
+            if (i < token.size() && (token[i] == '-' || token[i] == '+')) {
+                negative = token[i] == '-';
+                ++i;
+            }
+            if (i == token.size()) {
+                return false;
+            }
+            //накапливаем отрицательное значение: модуль минимума не меньше модуля максимума
+            T result = 0;
+            for (; i < token.size(); ++i) {
+                unsigned digit = (unsigned)(token[i] - '0');
+                if (digit > 9 || result < (numeric_limits<T>::min() + (T)digit) / 10) {
+                    return false;
+                }
+                result = result * 10 - (T)digit;
+            }
+            if (!negative && result < -numeric_limits<T>::max()) {
+                return false;
+            }
+            value = negative ? result : -result;
+            return true;
+        }
+        else {
+            //from_chars не зависит от локали (main включает системную, где разделитель может быть запятой)
+            //и не выделяет память; знак '+' он не принимает, поэтому пропускаем его сами
+            const char* first = token.data();
+            const char* last = token.data() + token.size();
+            if (first < last && *first == '+' && last - first > 1 && first[1] != '-' && first[1] != '+') {
+                ++first;
+            }
+            T result;
+            from_chars_result parsed = from_chars(first, last, result);
+            if (first == last || parsed.ec != errc() || parsed.ptr != last) {
+                return false;
+            }
+            value = result;
+            return true;
+        }
+    }
+};
+
+#endif  // EDGE_LIST_PARSER_H
@@ -0,0 +1,172 @@
+﻿#ifndef FLOYD_WARSHALL_H
+#define FLOYD_WARSHALL_H
+#include <vector>
+#include <new>
+#include <memory>
+#include <algorithm>
+#include <climits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "GraphResults.h"
+#include "ThreadPool.h"
+using namespace std;
+
+//кратчайшие расстояния между всеми парами вершин блочным алгоритмом Флойда-Уоршелла
+//матрицы dist и next хранятся одним выровненным массивом, строка дополнена до кратного BLOCK размера;
+//на каждом шаге k-блока сначала считается диагональный блок, затем параллельно блоки его строки и столбца,
+//затем параллельно все остальные блоки; внутренний цикл без ветвлений (AVX2, если включён при сборке)
+//веса не должны быть настолько большими, чтобы длины путей достигали INF
+class AllPairsShortestPaths {
+public:
+    static constexpr int INF = INT_MAX / 2;      //недостижимая пара (сумма двух INF не переполняет int)
+    static constexpr int BLOCK = 64;             //сторона блока, кратна 8 для AVX2
+
+private:
+    struct AlignedDelete {
+        void operator()(int* data) const {
+            ::operator delete[](data, align_val_t(64));
+        }
+    };
+    using AlignedArray = unique_ptr<int[], AlignedDelete>;
+
+    int numVertices = 0;
+    int stride = 0;                              //длина строки матрицы (numVertices, дополненное до BLOCK)
+    AlignedArray dist;                           //dist[i * stride + j] - длина кратчайшего пути i -> j
+    AlignedArray next;                           //следующая вершина на пути i -> j или -1
+    bool negativeCycle = false;
+
+    static AlignedArray allocate(size_t count) {
+        return AlignedArray(static_cast<int*>(::operator new[](count * sizeof(int), align_val_t(64))));
+    }
+
+    //di[j] = min(di[j], dik + dk[j]) для j из [0, count), вместе с next; dk[j] == INF не даёт пути
+    static void relaxRow(int* di, const int* dk, int* ni, int dik, int nik, int count) {
+        int j = 0;
+#ifdef __AVX2__
+        __m256i viaDist = _mm256_set1_epi32(dik);
+        __m256i viaNext = _mm256_set1_epi32(nik);
+        __m256i inf = _mm256_set1_epi32(INF);
+        for (; j + 8 <= count; j += 8) {
+            __m256i dkj = _mm256_load_si256((const __m256i*)(dk + j));
+            __m256i dij = _mm256_load_si256((const __m256i*)(di + j));
+            __m256i candidate = _mm256_add_epi32(viaDist, dkj);
+            __m256i better = _mm256_and_si256(_mm256_cmpgt_epi32(inf, dkj), _mm256_cmpgt_epi32(dij, candidate));
+            _mm256_store_si256((__m256i*)(di + j), _mm256_blendv_epi8(dij, candidate, better));
+            __m256i nij = _mm256_load_si256((const __m256i*)(ni + j));
+            _mm256_store_si256((__m256i*)(ni + j), _mm256_blendv_epi8(nij, viaNext, better));
+        }
+#endif
+        for (; j < count; ++j) {
+            int candidate = dik + dk[j];
+            bool better = (dk[j] < INF) & (candidate < di[j]);
+            di[j] = better ? candidate : di[j];
+            ni[j] = better ? nik : ni[j];
+        }
+    }
+
+    //обновление блока (ib, jb) через вершины k-блока kb
+    void updateBlock(int ib, int jb, int kb) {
+        int* d = dist.get();
+        int* nx = next.get();
+        int kEnd = kb * BLOCK + BLOCK;
+        int iEnd = ib * BLOCK + BLOCK;
+        for (int k = kb * BLOCK; k < kEnd; ++k) {
+            const int* dk = d + (size_t)k * stride + jb * BLOCK;
+            for (int i = ib * BLOCK; i < iEnd; ++i) {
+                int dik = d[(size_t)i * stride + k];
+                if (dik >= INF) continue; //через k из i не пройти, вся строка блока не меняется
+                relaxRow(d + (size_t)i * stride + jb * BLOCK, dk, nx + (size_t)i * stride + jb * BLOCK,
+                    dik, nx[(size_t)i * stride + k], BLOCK);
+            }
+        }
+    }
+
+public:
+    template <class G>
+    explicit AllPairsShortestPaths(const G& graph, ThreadPool& pool = ThreadPool::shared()) {
+        numVertices = graph.getNumVertices();
+        int blocks = (numVertices + BLOCK - 1) / BLOCK;
+        stride = blocks * BLOCK;
+        size_t cells = (size_t)stride * stride;
+        dist = allocate(cells);
+        next = allocate(cells);
+        fill(dist.get(), dist.get() + cells, INF);
+        fill(next.get(), next.get() + cells, -1);
+
+        //прямые рёбра (из нескольких параллельных берётся самое лёгкое)
+        for (int i = 0; i < numVertices; ++i) {
+            dist[(size_t)i * stride + i] = 0;
+            for (const auto& edge : graph.neighbors(i)) {
+                int& dij = dist[(size_t)i * stride + edge.to];
+                if (edge.weight < dij) {
+                    dij = edge.weight;
+                    next[(size_t)i * stride + edge.to] = edge.to;
+                }
+            }
+        }
+
+        for (int kb = 0; kb < blocks; ++kb) {
+            updateBlock(kb, kb, kb);
+            if (blocks == 1) break;
+            //строка и столбец k-блока
+            pool.parallelFor(2 * (blocks - 1), [&](int, int task) {
+                int other = task % (blocks - 1);
+                other += other >= kb ? 1 : 0;
+                if (task < blocks - 1) {
+                    updateBlock(kb, other, kb);
+                }
+                else {
+                    updateBlock(other, kb, kb);
+                }
+            });
+            //все остальные блоки
+            pool.parallelFor((blocks - 1) * (blocks - 1), [&](int, int task) {
+                int ib = task / (blocks - 1);
+                int jb = task % (blocks - 1);
+                ib += ib >= kb ? 1 : 0;
+                jb += jb >= kb ? 1 : 0;
+                updateBlock(ib, jb, kb);
+            });
+        }
+
+        for (int i = 0; i < numVertices; ++i) {
+            if (dist[(size_t)i * stride + i] < 0) {
+                negativeCycle = true;
+            }
+        }
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+    //в графе есть цикл отрицательного веса (расстояния через него не определены)
+    bool hasNegativeCycle() const {
+        return negativeCycle;
+    }
+    //длина кратчайшего пути u -> v или INF, если пути нет
+    int getDistance(int u, int v) const {
+        return dist[(size_t)u * stride + v];
+    }
+
+    //кратчайший путь u -> v по матрице next
+    PathResult getPath(int u, int v) const {
+        PathResult result;
+        if (getDistance(u, v) >= INF) {
+            return result;
+        }
+        result.vertices.push_back(u);
+        for (int current = u; current != v; ) {
+            current = next[(size_t)current * stride + v];
+            if (current == -1 || (int)result.vertices.size() > numVertices) {
+                return PathResult(); //путь проходит через отрицательный цикл
+            }
+            result.vertices.push_back(current);
+        }
+        result.found = true;
+        result.distance = getDistance(u, v);
+        return result;
+    }
+};
+
+#endif  // FLOYD_WARSHALL_H
@@ -11,37 +11,383 @@
 #include <queue>
 #include <SFML/Graphics.hpp>
 #include <random>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <atomic>
+#include <type_traits>
+#include "GraphFwd.h"
+#include "Edge.h"
+#include "GraphAlgorithms.h"
+#include "FloydWarshall.h"
+#include "MaxFlow.h"
+#include "VertexNames.h"
+#include "MappedFile.h"
+#include "EdgeListParser.h"
+#include "DisjointSets.h"
+#include "AdjacencyIndex.h"
+#include "BidirectionalDijkstra.h"
+#include "Landmarks.h"
+#include "ContractionHierarchy.h"
+#include "PathCache.h"
+#include "GraphArena.h"
+#include "Transpose.h"
+#include "TraceSink.h"
+#include "PerfCounters.h"
 using namespace std;
-struct Edge {
-    int to;        //конечная вершина
-    int weight;    //вес ребра
-    Edge(int to, int weight) : to(to), weight(weight) {}
+//что делать с повторяющимися рёбрами при загрузке из файла
+enum class DuplicatePolicy {
+    KeepAll,        //оставлять все рёбра как в файле
+    SkipExact,      //пропускать ребро с теми же концами и весом (как addEdge)
+    KeepMinWeight   //между парой вершин остаётся одно ребро с минимальным весом
 };
-class Graph {
+//граф с именованными вершинами
+//WeightT - тип веса (int, long long, double), IndexT - тип номера вершины в рёбрах списков смежности
+//(32-битный номер вместе с весом int дают ребро в 8 байт), D - ориентированность:
+//задана в типе (проверки ориентированности сворачиваются при компиляции) или Runtime - читается из файла
+//Дейкстра (обычный и двунаправленный), разрез и обращение работают с любым WeightT, поток - с целым;
+//Флойд-Уоршелл (матрица всех пар и путь не длиннее L), Борувка, ALT, иерархия сжатий и проверка N требуют
+//весов int: их матрицы, таблицы ориентиров, шорткаты, потенциалы и результаты хранят 32-битные расстояния,
+//а результаты общие с CsrGraph и меню; вызов такого метода для другого WeightT - ошибка компиляции
+//списки смежности и имена берут память у pmr::memory_resource, переданного в конструктор (например, GraphArena);
+//ресурс должен жить дольше графа, копия графа использует ресурс по умолчанию
+template <class WeightT, class IndexT, Directedness D>
+class BasicGraph {
+public:
+    using EdgeType = BasicEdge<WeightT, IndexT>;
+    using EdgeList = pmr::vector<EdgeType>;
+    using PathResultType = BasicPathResult<WeightT>;
+    using ShortestPathTreeType = BasicShortestPathTree<WeightT>;
+    //обращение ориентировано всегда: для неориентированного в типе графа это граф другого типа
+    using ReversedGraph = BasicGraph<WeightT, IndexT, D == Directedness::Runtime ? Directedness::Runtime : Directedness::Directed>;
+    static constexpr bool INT_WEIGHTS = is_same_v<WeightT, int>;
+
+    static_assert(is_integral_v<IndexT> && sizeof(IndexT) <= sizeof(int), "номер вершины - целое число не шире int");
+    static_assert(is_arithmetic_v<WeightT>, "вес ребра - число");
+
 private:
-    int numVertices;                             //кол-во вершин
-    bool directed;                               //флаг ориентированного/неориетированного графа
-    vector<vector<Edge>> adjList;                //список смежности с весами
-    unordered_map<string, int> nameToIndex;      //хэш-таблица для сопоставления имени вершины с индексом
-    unordered_map<int, string> indexToName;      //хэш-таблица для сопоставления индекса вершины с именем
+    using HubIndex = BasicAdjacencyIndex<WeightT>;
+
+    //reverseGraph заполняет поля обращения, тип которого может отличаться (неориентированный -> ориентированный)
+    template <class, class, Directedness>
+    friend class BasicGraph;
+
+    //удалённые вершины остаются в нумерации (без рёбер и без имени в хэш-таблице) до уплотнения,
+    //которое делают только removeVertex (при накоплении удалённых) и compact(): константные запросы
+    //нумерацию не меняют, индекс из findVertex() действителен до следующего изменения графа
+    int numVertices;                             //кол-во вершин (вместе с удалёнными до уплотнения)
+    bool directed;                               //флаг ориентированного/неориетированного графа (используется при D == Runtime)
+    pmr::vector<EdgeList> adjList;               //список смежности с весами
+    pmr::vector<EdgeList> reverseAdjList;        //входящие рёбра (только для ориентированного графа), to - начало ребра
+    VertexNames names;                           //имена вершин: индекс -> имя и хэш-таблица имя -> индекс
+    vector<char> removed;                        //отметки удалённых вершин
+    int removedCount = 0;
+    unordered_map<int, HubIndex> hubIndex;       //индексы списков смежности вершин с большой степенью
+    unordered_map<int, HubIndex> reverseHubIndex; //то же для списков входящих рёбер
+    size_t numArcs = 0;                          //записей во всех списках смежности
+    //компоненты слабой связности: поддерживаются при добавлении вершин и рёбер,
+    //после удаления помечаются устаревшими и перестраиваются при следующем запросе
+    mutable DisjointSets components;
+    mutable bool componentsDirty = false;
+    //версия содержимого: новое значение из общего счётчика при каждом изменении, поэтому у разных
+    //графов версии не совпадают и кэш кратчайших путей можно безопасно разделять между копиями
+    mutable uint64_t version = nextVersion();
+    shared_ptr<BasicShortestPathCache<WeightT>> pathCache = make_shared<BasicShortestPathCache<WeightT>>();
+    TraceSink* traceSink = nullptr;              //приёмник трассировки алгоритмов, не копируется вместе с графом
+
+    static uint64_t nextVersion() {
+        static atomic<uint64_t> counter{ 0 };
+        return ++counter;
+    }
 
-public:
-    //конструктор по умолчанию, который создает пустой граф
-    Graph(bool directed = false) : numVertices(0), directed(directed) {}
+    //перестраивает компоненты по спискам смежности за O(V + E)
+    void rebuildComponents() const {
+        components.reset(numVertices);
+        for (int u = 0; u < numVertices; ++u) {
+            for (const EdgeType& edge : adjList[u]) {
+                components.unite(u, edge.to);
+            }
+        }
+        componentsDirty = false;
+    }
 
-    //конструктор для загрузки графа из файла
-    Graph(const string& filename) {
-        ifstream file(filename);
-        if (!file) {
-            throw runtime_error("Ошибка открытия файла для чтения!");  // Выбрасываем исключение
+    //кол-во компонент слабой связности
+    //перестройка после удаления меняет mutable-поля, поэтому первый запрос после удаления
+    //не должен выполняться одновременно с другими запросами к графу
+    int countWeakComponents() const {
+        if (componentsDirty) {
+            rebuildComponents();
+        }
+        return components.count();
+    }
+
+    //удаляет из списка все рёбра в вершину target (с сохранением порядка остальных), возвращает их количество
+    static size_t eraseEdgesTo(EdgeList& edges, int target) {
+        size_t before = edges.size();
+        edges.erase(remove_if(edges.begin(), edges.end(),
+            [target](const EdgeType& edge) { return edge.to == target; }),
+            edges.end());
+        return before - edges.size();
+    }
+
+    //заводит индексы для всех списков со степенью не меньше порога
+    static void buildHubs(const pmr::vector<EdgeList>& lists, unordered_map<int, HubIndex>& hubs) {
+        hubs.clear();
+        for (int u = 0; u < (int)lists.size(); ++u) {
+            if (lists[u].size() >= HubIndex::DEGREE_THRESHOLD) {
+                hubs.emplace(u, HubIndex(lists[u]));
+            }
+        }
+    }
+
+    //добавляет ребро в список lists[from] и в его индекс (индекс заводится при достижении порога)
+    static void appendTo(pmr::vector<EdgeList>& lists, unordered_map<int, HubIndex>& hubs, int from, int to, WeightT weight) {
+        lists[from].push_back(EdgeType(to, weight));
+        auto hub = hubs.find(from);
+        if (hub != hubs.end()) {
+            hub->second.add(to, (int)lists[from].size() - 1);
+        }
+        else if (lists[from].size() >= HubIndex::DEGREE_THRESHOLD) {
+            hubs.emplace(from, HubIndex(lists[from]));
+        }
+    }
+
+    //удаляет из списка lists[from] все рёбра в to, возвращает их количество
+    //список с индексом обходится без просмотра (порядок остальных рёбер меняется), остальные просматриваются целиком
+    static size_t eraseFrom(pmr::vector<EdgeList>& lists, unordered_map<int, HubIndex>& hubs, int from, int to) {
+        auto hub = hubs.find(from);
+        if (hub != hubs.end()) {
+            return hub->second.eraseTarget(lists[from], to);
+        }
+        return eraseEdgesTo(lists[from], to);
+    }
+
+    void rebuildHubIndex() {
+        buildHubs(adjList, hubIndex);
+        buildHubs(reverseAdjList, reverseHubIndex);
+    }
+
+    //есть ли ребро from -> to (с весом weight, если weight задан); O(1) для вершин с индексом
+    bool containsArc(int from, int to) const {
+        auto hub = hubIndex.find(from);
+        if (hub != hubIndex.end()) {
+            return hub->second.contains(to);
+        }
+        for (const EdgeType& edge : adjList[from]) {
+            if (edge.to == to) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool containsArc(int from, int to, WeightT weight) const {
+        auto hub = hubIndex.find(from);
+        if (hub != hubIndex.end()) {
+            return hub->second.contains(adjList[from], to, weight);
+        }
+        for (const EdgeType& edge : adjList[from]) {
+            if (edge.to == to && edge.weight == weight) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void appendArc(int from, int to, WeightT weight) {
+        appendTo(adjList, hubIndex, from, to, weight);
+        ++numArcs;
+    }
+
+    size_t eraseArcs(int from, int to) {
+        size_t erased = eraseFrom(adjList, hubIndex, from, to);
+        numArcs -= erased;
+        return erased;
+    }
+
+    //уплотняет нумерацию: удалённые вершины исчезают, остальные сдвигаются с сохранением порядка
+    //концы рёбер перенумеровываются параллельно на пуле потоков, списки переносятся без копирования
+    void compactStorage() {
+        if (removedCount == 0) {
+            return;
+        }
+        PERF_PHASE("compact");
+        vector<int> remap(numVertices, -1);
+        int kept = 0;
+        for (int u = 0; u < numVertices; ++u) {
+            if (!removed[u]) {
+                remap[u] = kept++;
+            }
+        }
+
+        const int CHUNK = 1024;
+        ThreadPool::shared().parallelFor((numVertices + CHUNK - 1) / CHUNK, [&](int, int chunk) {
+            int last = min(numVertices, (chunk + 1) * CHUNK);
+            for (int u = chunk * CHUNK; u < last; ++u) {
+                for (EdgeType& edge : adjList[u]) {
+                    edge.to = remap[edge.to];
+                }
+                if (isDirected()) {
+                    for (EdgeType& edge : reverseAdjList[u]) {
+                        edge.to = remap[edge.to];
+                    }
+                }
+            }
+        });
+
+        for (int u = 0; u < numVertices; ++u) {
+            if (remap[u] != -1 && remap[u] != u) {
+                adjList[remap[u]] = move(adjList[u]);
+                if (isDirected()) {
+                    reverseAdjList[remap[u]] = move(reverseAdjList[u]);
+                }
+            }
+        }
+        adjList.resize(kept);
+        if (isDirected()) {
+            reverseAdjList.resize(kept);
+        }
+        names.compact(remap);
+        numVertices = kept;
+        rebuildHubIndex();
+        removed.assign(kept, 0);
+        removedCount = 0;
+        componentsDirty = true;
+        version = nextVersion(); //индексы вершин изменились
+    }
+
+    //делает граф пустым после перемещения из него (ориентированность и ресурс памяти остаются)
+    void clearMovedFrom() {
+        numVertices = 0;
+        adjList.clear();
+        reverseAdjList.clear();
+        names.clear();
+        removed.clear();
+        removedCount = 0;
+        hubIndex.clear();
+        reverseHubIndex.clear();
+        numArcs = 0;
+        components.reset(0);
+        componentsDirty = false;
+        version = nextVersion();
+    }
+
+    //считает дерево от start и кладёт его в кэш (при нулевой ёмкости кэш его не сохраняет)
+    shared_ptr<const ShortestPathTreeType> buildShortestPathTree(int start) const {
+        PERF_PHASE("shortest-path-tree");
+        auto tree = make_shared<ShortestPathTreeType>();
+        BasicDijkstraEngine<WeightT>& engine = BasicDijkstraEngine<WeightT>::local();
+        engine.findAllDistances(*this, start);
+        tree->distance.resize(numVertices);
+        tree->predecessor.resize(numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            tree->distance[v] = engine.getDistance(v);
+            tree->predecessor[v] = engine.getPredecessor(v);
+        }
+        pathCache->storeTree(version, start, tree);
+        return tree;
+    }
+
+    //копирует содержимое copy; pmr-контейнеры и имена при присваивании оставляют себе свой ресурс памяти
+    void copyContents(const BasicGraph& copy) {
+        numVertices = copy.numVertices;
+        directed = copy.directed;
+        adjList = copy.adjList;
+        reverseAdjList = copy.reverseAdjList;
+        names = copy.names;
+        removed = copy.removed;
+        removedCount = copy.removedCount;
+        hubIndex = copy.hubIndex;
+        reverseHubIndex = copy.reverseHubIndex;
+        numArcs = copy.numArcs;
+        components = copy.components;
+        componentsDirty = copy.componentsDirty;
+        version = copy.version;
+    }
+
+    //ребро в порядке чтения из файла
+    struct RawEdge {
+        int from;
+        int to;
+        WeightT weight;
+    };
+
+    //отмечает повторяющиеся рёбра согласно политике, возвращает их количество
+    //рёбра группируются сортировкой подсчётом по меньшему концу (по началу для ориентированного графа),
+    //внутри группы повтор второго конца ищется по отметкам, так что проход линейный
+    size_t markDuplicates(vector<RawEdge>& edges, vector<char>& keep, DuplicatePolicy duplicates) const {
+        int n = names.size();
+        vector<size_t> start(n + 1, 0);
+        auto key = [this](const RawEdge& edge) {
+            return isDirected() ? make_pair(edge.from, edge.to) : make_pair(min(edge.from, edge.to), max(edge.from, edge.to));
+        };
+        for (const RawEdge& edge : edges) {
+            ++start[key(edge).first + 1];
+        }
+        for (int u = 0; u < n; ++u) {
+            start[u + 1] += start[u];
+        }
+        vector<size_t> order(edges.size());
+        vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            order[fill[key(edges[i]).first]++] = i;
+        }
+
+        vector<int> stamp(n, -1);               //группа, в которой второй конец уже встречался
+        vector<size_t> first(n);                //первое ребро с этим вторым концом в группе
+        vector<size_t> nextSame(edges.size());  //следующее оставленное ребро с теми же концами
+        size_t skipped = 0;
+        for (int a = 0; a < n; ++a) {
+            for (size_t pos = start[a]; pos < start[a + 1]; ++pos) {
+                size_t id = order[pos];
+                int b = key(edges[id]).second;
+                nextSame[id] = SIZE_MAX;
+                if (stamp[b] != a) {
+                    stamp[b] = a;
+                    first[b] = id;
+                    continue;
+                }
+                if (duplicates == DuplicatePolicy::KeepMinWeight) {
+                    RawEdge& kept = edges[first[b]];
+                    kept.weight = min(kept.weight, edges[id].weight);
+                    keep[id] = 0;
+                    ++skipped;
+                    continue;
+                }
+                //SkipExact: ищем среди оставленных рёбер с теми же концами ребро с тем же весом
+                size_t last = first[b];
+                bool same = false;
+                for (size_t other = first[b]; other != SIZE_MAX; other = nextSame[other]) {
+                    if (edges[other].weight == edges[id].weight) {
+                        same = true;
+                        break;
+                    }
+                    last = other;
+                }
+                if (same) {
+                    keep[id] = 0;
+                    ++skipped;
+                }
+                else {
+                    nextSame[last] = id;
+                }
+            }
         }
+        return skipped;
+    }
 
-        string type;
-        // Используем std::getline для считывания типа графа
-        if (!getline(file, type)) {
+    //быстрая загрузка: файл отображается в память и разбирается без iostream,
+    //имена добавляются в таблицу за один проход, списки смежности заполняются
+    //сортировкой подсчётом по начальной вершине с сохранением порядка рёбер из файла
+    size_t loadEdgeList(const string& filename, DuplicatePolicy duplicates) {
+        PERF_PHASE("load");
+        MappedFile file(filename);
+        if (file.size() == 0) {
             throw runtime_error("Ошибка чтения типа графа из файла!");
         }
+        EdgeListParser parser(file.data(), file.size());
 
+        string type(parser.readLine());
         // Удаляем лишние пробелы
         type.erase(remove_if(type.begin(), type.end(), ::isspace), type.end());
 
@@ -55,148 +401,306 @@ public:
         else {
             throw runtime_error("Некорректный тип графа в файле: " + type);
         }
+        if (D != Directedness::Runtime && directed != (D == Directedness::Directed)) {
+            throw runtime_error("Тип графа в файле (" + type + ") не совпадает с ориентированностью, заданной в типе графа");
+        }
 
-        string from, to;
-        int weight;
-        nameToIndex.clear();
-        indexToName.clear();
+        names.clear();
         adjList.clear();
+        reverseAdjList.clear();
         numVertices = 0;
+        numArcs = 0;
 
         // Читаем рёбра
-        while (file >> from >> to >> weight) {
-            addEdge(from, to, weight);
+        vector<RawEdge> edges;
+        string_view from, to, weight;
+        while (parser.nextToken(from)) {
+            WeightT value;
+            if (!parser.nextToken(to) || !parser.nextToken(weight) || !EdgeListParser::parseNumber(weight, value)) {
+                throw runtime_error("Некорректная запись ребра №" + to_string(edges.size() + 1) + " в файле " + filename);
+            }
+            int u = names.add(from);
+            int v = names.add(to);
+            edges.push_back({ u, v, value });
+        }
+
+        vector<char> keep(edges.size(), 1);
+        size_t skipped = 0;
+        if (duplicates != DuplicatePolicy::KeepAll) {
+            skipped = markDuplicates(edges, keep, duplicates);
         }
 
-        file.close();
+        numVertices = names.size();
+        vector<int> degree(numVertices, 0);
+        for (size_t i = 0; i < edges.size(); ++i) {
+            if (keep[i]) {
+                ++degree[edges[i].from];
+                if (!isDirected()) {
+                    ++degree[edges[i].to];
+                }
+            }
+        }
+        adjList.resize(numVertices);
+        for (int u = 0; u < numVertices; ++u) {
+            adjList[u].reserve(degree[u]);
+        }
+        for (size_t i = 0; i < edges.size(); ++i) {
+            if (keep[i]) {
+                const RawEdge& edge = edges[i];
+                adjList[edge.from].push_back(EdgeType(edge.to, edge.weight));
+                if (!isDirected()) {
+                    adjList[edge.to].push_back(EdgeType(edge.from, edge.weight));
+                }
+            }
+        }
+        for (int u = 0; u < numVertices; ++u) {
+            numArcs += adjList[u].size();
+        }
+        if (isDirected()) {
+            //входящие рёбра в том же порядке, в котором их начала идут в нумерации
+            vector<int> inDegree(numVertices, 0);
+            for (int u = 0; u < numVertices; ++u) {
+                for (const EdgeType& edge : adjList[u]) {
+                    ++inDegree[edge.to];
+                }
+            }
+            reverseAdjList.resize(numVertices);
+            for (int u = 0; u < numVertices; ++u) {
+                reverseAdjList[u].reserve(inDegree[u]);
+            }
+            for (int u = 0; u < numVertices; ++u) {
+                for (const EdgeType& edge : adjList[u]) {
+                    reverseAdjList[edge.to].push_back(EdgeType(u, edge.weight));
+                }
+            }
+        }
+        removed.assign(numVertices, 0);
+        removedCount = 0;
+        rebuildHubIndex();
+        rebuildComponents();
+        return skipped;
+    }
+
+public:
+    //конструктор по умолчанию, который создает пустой граф
+    BasicGraph(bool directed = D == Directedness::Directed, pmr::memory_resource* resource = pmr::get_default_resource())
+        : numVertices(0), directed(directed), adjList(resource), reverseAdjList(resource), names(resource) {
+        if (D != Directedness::Runtime && directed != (D == Directedness::Directed)) {
+            throw runtime_error("Ориентированность графа задана в его типе");
+        }
+    }
+
+    //конструктор для загрузки графа из файла
+    BasicGraph(const string& filename, DuplicatePolicy duplicates = DuplicatePolicy::SkipExact,
+        pmr::memory_resource* resource = pmr::get_default_resource())
+        : numVertices(0), directed(D == Directedness::Directed), adjList(resource), reverseAdjList(resource), names(resource) {
+        size_t skipped = loadEdgeList(filename, duplicates);
         cout << "Граф загружен из файла " << filename << endl;
+        if (skipped > 0) {
+            cout << "Пропущено повторяющихся рёбер: " << skipped << endl;
+        }
     }
-    Graph(const Graph& copy) {
-        numVertices = copy.numVertices;
-        directed = copy.directed;
-        adjList = copy.adjList;  
-        nameToIndex = copy.nameToIndex;  
-        indexToName = copy.indexToName;  
+    //строковый литерал иначе выбрал бы конструктор с bool
+    BasicGraph(const char* filename, DuplicatePolicy duplicates = DuplicatePolicy::SkipExact,
+        pmr::memory_resource* resource = pmr::get_default_resource())
+        : BasicGraph(string(filename), duplicates, resource) {}
+    BasicGraph(const BasicGraph& copy) {
+        copyContents(copy);
+    }
+    //перемещение передаёт списки смежности, имена и индексы без копирования; кэш путей становится общим
+    //(записи привязаны к версии, а исходный граф получает новую), приёмник трассировки переходит вместе с графом
+    BasicGraph(BasicGraph&& other) noexcept
+        : numVertices(other.numVertices), directed(other.directed), adjList(move(other.adjList)),
+        reverseAdjList(move(other.reverseAdjList)), names(move(other.names)), removed(move(other.removed)),
+        removedCount(other.removedCount), hubIndex(move(other.hubIndex)),
+        reverseHubIndex(move(other.reverseHubIndex)), numArcs(other.numArcs),
+        components(move(other.components)), componentsDirty(other.componentsDirty), version(other.version),
+        pathCache(other.pathCache), traceSink(other.traceSink) {
+        other.clearMovedFrom();
     }
+    //присваивание оставляет графу его ресурс памяти и приёмник трассировки; при разных ресурсах
+    //списки смежности переносятся поэлементно (так устроены pmr-контейнеры), при одинаковых - без копирования
+    BasicGraph& operator=(BasicGraph&& other) {
+        if (this != &other) {
+            numVertices = other.numVertices;
+            directed = other.directed;
+            adjList = move(other.adjList);
+            reverseAdjList = move(other.reverseAdjList);
+            names = move(other.names);
+            removed = move(other.removed);
+            removedCount = other.removedCount;
+            hubIndex = move(other.hubIndex);
+            reverseHubIndex = move(other.reverseHubIndex);
+            numArcs = other.numArcs;
+            components = move(other.components);
+            componentsDirty = other.componentsDirty;
+            version = other.version;
+            pathCache = other.pathCache;
+            other.clearMovedFrom();
+        }
+        return *this;
+    }
+    //копирование сразу в память этого графа, без промежуточной копии; кэш путей и приёмник трассировки свои
+    BasicGraph& operator=(const BasicGraph& copy) {
+        if (this != &copy) {
+            copyContents(copy);
+        }
+        return *this;
+    }
+    //ресурс памяти списков смежности и имён
+    pmr::memory_resource* getMemoryResource() const {
+        return adjList.get_allocator().resource();
+    }
+    //при ориентированности, заданной в типе, - константа времени компиляции
     bool isDirected() const {
-        return directed;
+        if constexpr (D == Directedness::Runtime) {
+            return directed;
+        }
+        else {
+            return D == Directedness::Directed;
+        }
+    }
+    //заранее выделяет память под vertices вершин (списки, имена, компоненты), чтобы addVertex не перераспределял её
+    void reserve(size_t vertices) {
+        adjList.reserve(vertices);
+        if (isDirected()) {
+            reverseAdjList.reserve(vertices);
+        }
+        names.reserve(vertices);
+        removed.reserve(vertices);
+        components.reserve((int)vertices);
+    }
+    //заранее выделяет место под count исходящих рёбер вершины (если известна её степень)
+    void reserveEdges(const string& name, size_t count) {
+        int index = names.find(name);
+        if (index == -1) {
+            throw runtime_error("Вершина " + name + " не найдена");
+        }
+        adjList[index].reserve(count);
     }
     //метод для добавления вершины
     void addVertex(const string& name) {
-        if (nameToIndex.find(name) != nameToIndex.end()) {
+        if (names.find(name) != -1) {
             return; // Если вершина уже существует, ничего не делаем
         }
-        nameToIndex[name] = numVertices;
-        indexToName[numVertices] = name;
-        adjList.push_back(vector<Edge>());
+        names.add(name);
+        adjList.emplace_back(); //список получает ресурс графа
+        if (isDirected()) {
+            reverseAdjList.emplace_back();
+        }
+        removed.push_back(0);
+        components.add();
         ++numVertices;
+        version = nextVersion();
     }
 
 
 
     //метод для добавления ребра
-    void addEdge(const string& from, const string& to, int weight) {
+    void addEdge(const string& from, const string& to, WeightT weight) {
         // Добавляем вершины только если они еще не существуют
-        if (nameToIndex.find(from) == nameToIndex.end()) {
+        int u = names.find(from);
+        if (u == -1) {
             addVertex(from);
+            u = numVertices - 1;
         }
-        if (nameToIndex.find(to) == nameToIndex.end()) {
+        int v = names.find(to);
+        if (v == -1) {
             addVertex(to);
+            v = numVertices - 1;
         }
 
-        int u = nameToIndex[from];
-        int v = nameToIndex[to];
-
         // Проверка на существующее ребро
-        for (const Edge& edge : adjList[u]) {
-            if (edge.to == v && edge.weight == weight) {
-                cout << "Ошибка: Ребро между \"" << from << "\" и \"" << to
-                    << "\" с весом " << weight << " уже существует." << endl;
-                return;
-            }
+        if (containsArc(u, v, weight)) {
+            cout << "Ошибка: Ребро между \"" << from << "\" и \"" << to
+                << "\" с весом " << weight << " уже существует." << endl;
+            return;
         }
 
         // Добавляем ребро
-        adjList[u].push_back(Edge(v, weight));
-        if (!directed) {
-            adjList[v].push_back(Edge(u, weight));
+        appendArc(u, v, weight);
+        if (isDirected()) {
+            appendTo(reverseAdjList, reverseHubIndex, v, u, weight);
+        }
+        else {
+            appendArc(v, u, weight);
         }
+        if (!componentsDirty) {
+            components.unite(u, v);
+        }
+        version = nextVersion();
     }
 
     //метод для удаления вершины
+    //вершина помечается удалённой, рёбра снимаются только у её соседей (по обратным спискам), O(степени);
+    //нумерация уплотняется при накоплении четверти удалённых вершин или явным вызовом compact()
     void removeVertex(const string& name) { //проверка на существование вершины
-        if (nameToIndex.find(name) == nameToIndex.end()) {
+        int index = names.find(name); //индекс удаляемой вершины
+        if (index == -1) {
             cout << "Вершина не найдена."<<endl;
             return;
         }
 
-        int index = nameToIndex[name]; //индекс удаляемой вершины
-
-        
-        for (auto& edges : adjList) { //удаляем все ребра, который входят и выходят из вершины
-            edges.erase(remove_if(edges.begin(), edges.end(),
-                [index](const Edge& edge) { return edge.to == index; }),
-                edges.end());
+        for (const EdgeType& edge : adjList[index]) { //у концов исходящих рёбер убираем обратные записи
+            if (edge.to == index) continue;
+            if (isDirected()) {
+                eraseFrom(reverseAdjList, reverseHubIndex, edge.to, index);
+            }
+            else {
+                eraseArcs(edge.to, index);
+            }
         }
-
-        adjList.erase(adjList.begin() + index); //удаляем список смежности для данной вершины
-       
-        for (auto& edges : adjList) { //перенумеруем все вершины, у которых индекс больше, чем у удаленной вершины
-            for (auto& edge : edges) {
-                if (edge.to > index) {
-                    --edge.to;  //смещаем индекс на -1
+        if (isDirected()) {
+            for (const EdgeType& edge : reverseAdjList[index]) { //у начал входящих рёбер убираем сами рёбра
+                if (edge.to != index) {
+                    eraseArcs(edge.to, index);
                 }
             }
+            EdgeList(reverseAdjList.get_allocator()).swap(reverseAdjList[index]);
+            reverseHubIndex.erase(index);
         }
+        numArcs -= adjList[index].size();
+        EdgeList(adjList.get_allocator()).swap(adjList[index]);
+        hubIndex.erase(index);
 
-        
-        unordered_map<string, int> newNameToIndex; 
-        unordered_map<int, string> newIndexToName;
-
-        int newIndex = 0;
-        for (const auto& pair : indexToName) { //обновляем хэш-таблицы
-            if (pair.first != index) {  
-                newIndexToName[newIndex] = pair.second;
-                newNameToIndex[pair.second] = newIndex;
-                ++newIndex;
-            }
+        names.unlink(index);
+        removed[index] = 1;
+        ++removedCount;
+        componentsDirty = true;
+        version = nextVersion();
+        if (removedCount * 4 >= numVertices) {
+            compactStorage();
         }
+    }
 
-        nameToIndex = move(newNameToIndex); //заменяем старые хэш-таблицы на новые 
-        indexToName = move(newIndexToName);
-        --numVertices;  
+    //уплотняет нумерацию вершин после удалений
+    void compact() {
+        compactStorage();
     }
 
 
     //метод для удаления ребра 
     void removeEdge(const string& from, const string& to) {
-        if (nameToIndex.find(from) == nameToIndex.end() || nameToIndex.find(to) == nameToIndex.end()) { //проверка на существование указанных вершин между которыми удаляется ребро
+        int u = names.find(from); //получаем индексы вершин
+        int v = names.find(to);
+        if (u == -1 || v == -1) { //проверка на существование указанных вершин между которыми удаляется ребро
             cout << "Одна из вершин (или обе) не существует." << endl;
             return;
         }
-        int u = nameToIndex[from]; //получаем индексы вершин
-        int v = nameToIndex[to];
-        bool edgeExists = false;
-        for (const Edge& edge : adjList[u]) {
-            if (edge.to == v) {
-                edgeExists = true;
-                break;
-            }
-        }
-
-        if (!edgeExists) {
+        if (!containsArc(u, v)) {
             cout << "Ребро между " << from << " и " << to << " не существует." << endl;
             return;
         }
-        adjList[u].erase(remove_if(adjList[u].begin(), adjList[u].end(), //удаление ребра из списка смежности вершины u (from) 
-            [v](const Edge& edge) { return edge.to == v; }),
-            adjList[u].end());
+        eraseArcs(u, v); //удаление ребра из списка смежности вершины u (from)
 
-        if (!directed) { //если граф неориентированный, то удаляем обратное ребро
-            adjList[v].erase(remove_if(adjList[v].begin(), adjList[v].end(),
-                [u](const Edge& edge) { return edge.to == u; }),
-                adjList[v].end());
+        if (!isDirected()) { //если граф неориентированный, то удаляем обратное ребро
+            eraseArcs(v, u);
         }
+        else {
+            eraseFrom(reverseAdjList, reverseHubIndex, v, u);
+        }
+        componentsDirty = true;
+        version = nextVersion();
     }
 
     //метод для сохранения граф в файл
@@ -207,7 +711,7 @@ public:
             cout << "Ошибка открытия файла для записи!" << endl;
             return;
         }
-        if (directed) {
+        if (isDirected()) {
             outFile << "Directed\n";
         }
         else {
@@ -216,11 +720,11 @@ public:
 
         //записываем ребра
         for (int u = 0; u < numVertices; ++u) {
-            for (const Edge& edge : adjList[u]) {
+            for (const EdgeType& edge : adjList[u]) {
                 //если граф неориентированный, пропускаем записи обратных рёбер
-                if (directed || u < edge.to) {
-                    outFile << indexToName.at(u) << " "
-                        << indexToName.at(edge.to) << " "
+                if (isDirected() || u < edge.to) {
+                    outFile << names[u] << " "
+                        << names[edge.to] << " "
                         << edge.weight << "\n";
                 }
             }
@@ -233,523 +737,323 @@ public:
     //метод для вывода списка смежности
     void printAdjList() const {
         for (int u = 0; u < numVertices; ++u) {
-            cout << indexToName.at(u) << ": ";
-            for (const Edge& edge : adjList[u]) {
-                cout << "(" << indexToName.at(edge.to) << ", вес: " << edge.weight << ") ";
+            if (removed[u]) {
+                continue;
+            }
+            cout << names[u] << ": ";
+            for (const EdgeType& edge : adjList[u]) {
+                cout << "(" << names[edge.to] << ", вес: " << edge.weight << ") ";
             }
             cout << endl;
         }
     }
 
 
-    void findCommonTarget(const string& u, const string& v) {
-        if (nameToIndex.find(u) == nameToIndex.end() || nameToIndex.find(v) == nameToIndex.end()) {
-            cout << "Одна или обе вершины не существуют!" << endl;
-            return;
-        }
-
-        int uIndex = nameToIndex[u]; //извлекаем индексы вершин из хэш-таблицы
-        int vIndex = nameToIndex[v]; 
-
-        unordered_set<int> targetsFromU; //множества для хранения конечных вершин, в которые ведут рёбра из u и v
-        unordered_set<int> targetsFromV;
-
-        
-        for (const Edge& edge : adjList[uIndex]) { //проходим по ребрам и ищем конечные вершины для u 
-            targetsFromU.insert(edge.to);
-        }
-
-     
-        for (const Edge& edge : adjList[vIndex]) { //проходим по ребрам и ищем конечные вершины для v
-            targetsFromV.insert(edge.to);
+    //общая вершина, в которую ведут дуги из u и из v; found == false, если её нет или нет одной из вершин
+    CommonTargetResult findCommonTarget(const string& u, const string& v) const {
+        CommonTargetResult result;
+        int uIndex = names.find(u); //извлекаем индексы вершин из хэш-таблицы
+        int vIndex = names.find(v);
+        if (uIndex == -1 || vIndex == -1) {
+            return result;
         }
 
-        
-        for (int target : targetsFromU) { //ищем пересечение двух множеств
-            if (targetsFromV.find(target) != targetsFromV.end()) {
-                cout << "Общая вершина: " << indexToName[target] << endl;
-                return;
+        //первая дуга из v в конец какой-либо дуги из u: у вершины с большой степенью проверка
+        //идёт по её хэш-индексу, у остальных - по короткому списку, без вспомогательных множеств
+        for (const EdgeType& edge : adjList[vIndex]) {
+            if (containsArc(uIndex, edge.to)) {
+                result.found = true;
+                result.vertex = edge.to;
+                return result;
             }
         }
-
-        cout << "Нет общей вершины, в которую ведут дуги как из " << u << " и из " << v << endl;
+        return result;
     }
 
-
-    void getOutDegree(const string& vertexName) {
-        if (nameToIndex.find(vertexName) == nameToIndex.end()) {
-            cout << "Вершина " << vertexName << " не найдена!" << endl;
-            return;
+    //полустепень исхода вершины или -1, если вершины нет
+    int getOutDegree(const string& vertexName) const {
+        int vertexIndex = names.find(vertexName); //индекс вершины
+        if (vertexIndex == -1) {
+            return -1;
         }
-
-        int vertexIndex = nameToIndex[vertexName]; //индекс вершины
-        int outDegree = adjList[vertexIndex].size();  //кол-во ребер, исходящих из вершины 
-
-        cout << "Полустепень исхода вершины " << vertexName << " : " << outDegree << endl;
+        return (int)adjList[vertexIndex].size();  //кол-во ребер, исходящих из вершины
     }
 
-    Graph reverseGraph() const {
-        Graph reversedGraph(true); // Новый граф должен быть ориентированным
-
-        for (int i = 0; i < numVertices; ++i) { // Добавляем обратные ребра в новый граф
-            for (const Edge& edge : adjList[i]) {
-                reversedGraph.addEdge(indexToName.at(edge.to), indexToName.at(i), edge.weight);
-            }
-        }
-
-        cout << "Граф загружен в файл reversed_graph.txt";
-        reversedGraph.saveToFile("reversed_graph.txt");
+    //обращение графа (ориентированный граф с развёрнутыми рёбрами) в памяти за O(V + E):
+    //нумерация и имена вершин те же (таблица имён копируется целиком, без поиска по именам),
+    //списки смежности - транспонирование сортировкой подсчётом на пуле потоков,
+    //входящие рёбра обращения - это исходящие рёбра графа, компоненты слабой связности не меняются
+    //для обратных поисков без копирования есть reverseView()
+    ReversedGraph reverseGraph() const {
+        PERF_PHASE("reverse");
+        ReversedGraph reversedGraph(true); // Новый граф должен быть ориентированным
+
+        TransposeBuilder transpose(*this);
+        const vector<int>& inDegree = transpose.getInDegrees();
+        reversedGraph.numVertices = numVertices;
+        reversedGraph.names = names;
+        reversedGraph.adjList.resize(numVertices);
+        for (int v = 0; v < numVertices; ++v) {
+            reversedGraph.adjList[v].resize(inDegree[v], EdgeType(0, WeightT()));
+        }
+        transpose.fill(*this, [&](int v, int pos, int from, WeightT weight) {
+            reversedGraph.adjList[v][pos] = EdgeType(from, weight);
+        });
+        reversedGraph.reverseAdjList.assign(adjList.begin(), adjList.end());
+        reversedGraph.numArcs = numArcs;
+        reversedGraph.removed = removed; //та же нумерация, вместе с удалёнными вершинами
+        reversedGraph.removedCount = removedCount;
+        reversedGraph.components = components;
+        reversedGraph.componentsDirty = componentsDirty;
+        reversedGraph.rebuildHubIndex();
         return reversedGraph;
     }
 
     //5-6 task
     //функция для проверки, можно ли отключить две вершины, используя не более k рёбер
-    bool canDisconnectWithKEdges(const string& u, const string& v, int k, bool isDirected) {
-        if (nameToIndex.find(u) == nameToIndex.end() || nameToIndex.find(v) == nameToIndex.end()) {
-            cout << "Одна или обе вершины не существуют!" << endl;
-            return false;
-        }
-
-        int uIndex = nameToIndex[u];
-        int vIndex = nameToIndex[v];
-
-        if (!hasPath(uIndex, vIndex)) {
-            cout << "Вершины " << u << " и " << v << " уже отключены." << endl;
-            return true;
-        }
-
-        if (isDirected) {
-            //для ориентированного графа — проверяем все исходящие рёбра из u
-            vector<pair<int, int>> edgesToDisconnect;
-            for (const Edge& edge : adjList[uIndex]) {
-                int nextNode = edge.to;
-                if (hasPath(nextNode, vIndex)) {
-                    edgesToDisconnect.push_back({ uIndex, nextNode });
-                }
-            }
-
-            if (edgesToDisconnect.size() <= k) {
-                cout << "Можно отключить путь между " << u << " и " << v << " с помощью отключения "
-                    << edgesToDisconnect.size() << " рёбер." << endl;
-                cout << "Рёбра для отключения: ";
-                for (const auto& edge : edgesToDisconnect) {
-                    cout << "(" << indexToName[edge.first] << ", " << indexToName[edge.second] << ") ";
-                }
-                cout << endl;
-                return true;
-            }
-            else {
-                cout << "Невозможно отключить путь между " << u << " и " << v << " с помощью " << k
-                    << " рёбер." << endl;
-                return false;
-            }
-        }
-        else {
-            //для неориентированного графа подсчитываем степень вершин
-            int degreeU = adjList[uIndex].size(); //количество рёбер, связанных с вершиной u
-            int degreeV = adjList[vIndex].size(); //количество рёбер, связанных с вершиной v
-
-            if (degreeU <= k || degreeV <= k) {
-                cout << "Можно отключить путь между " << u << " и " << v << " удалив рёбра." << endl;
-                cout << "Степень " << u << ": " << degreeU << ", степень " << v << ": " << degreeV << endl;
-                return true;
-            }
-            else {
-                cout << "Невозможно отключить путь между " << u << " и " << v << " с помощью " << k
-                    << " рёбер." << endl;
-                return false;
-            }
-        }
+    //(точный минимальный разрез через поток единичной пропускной способности)
+    EdgeCutResult canDisconnectWithKEdges(const string& u, const string& v, int k, bool isDirected) const {
+        PERF_PHASE("edge-cut");
+        int uIndex = names.find(u);
+        int vIndex = names.find(v);
+        if (uIndex == -1 || vIndex == -1) {
+            return EdgeCutResult();
+        }
+        return algo::findEdgeCut(*this, uIndex, vIndex, k, isDirected);
     }
 
 
     //функция проверки существования пути между двумя вершинами
-    bool hasPath(int u, int v) {
-        vector<bool> visited(numVertices, false);
-        return dfs(u, v, visited);
+    bool hasPath(int u, int v) const {
+        return algo::hasPath(*this, u, v);
     }
 
-    // вспомогательная функция DFS для проверки пути
-    bool dfs(int u, int v, vector<bool>& visited) {
-        if (u == v) return true; // если достигли целевой вершины
-        visited[u] = true;
-        for (const Edge& edge : adjList[u]) {
-            if (!visited[edge.to] && dfs(edge.to, v, visited)) return true;
-        }
-        return false;
-    }
-    //метод для нахождения цикломатического числа графа
+    //метод для нахождения цикломатического числа графа: E - V + P, где P - кол-во компонент слабой связности
+    //счётчик рёбер и компоненты поддерживаются при изменениях графа, поэтому запрос O(1)
     int findCyclomaticNumber() const {
-        int edgeCount = 0;
-        for (const auto& edges : adjList) { //подсчитываем кол-во ребер для каждой вершины
-            edgeCount += edges.size();
-        }
-        
-        if (!directed) { //для неориентированного графа (ребра делятся на два, т.к. они дважды записаны в список смежности)
-            edgeCount /= 2;
-        }
-
-        int componentCount = countConnectedComponents();
-        return edgeCount - numVertices + componentCount;
+        //для неориентированного графа ребра делятся на два, т.к. они дважды записаны в список смежности
+        int edgeCount = (int)(isDirected() ? numArcs : numArcs / 2);
+        return edgeCount - numVertices + countWeakComponents();
     }
 
-    int countConnectedComponents() const { //метод для проверки посещенных вершин
-        vector<bool> visited(numVertices, false);
-        int componentCount = 0;
-
-        for (int i = 0; i < numVertices; ++i) {
-            if (!visited[i]) {
-                ++componentCount;
-                dfsForComponents(i, visited);
-            }
+    int countConnectedComponents() const { //метод для подсчёта компонент связности
+        PERF_PHASE("components");
+        //удалённые вершины до уплотнения изолированы, каждая учтена отдельной компонентой
+        if (!isDirected()) {
+            return countWeakComponents() - removedCount; //в неориентированном графе совпадают с компонентами обхода
         }
-
-        return componentCount;
+        return algo::countConnectedComponents(*this) - removedCount;
     }
 
-    //dfs для обхода всех вершин, которые связаны с начальной
-    void dfsForComponents(int vertex, vector<bool>& visited) const {
-        visited[vertex] = true; 
-        for (const Edge& edge : adjList[vertex]) {
-            if (!visited[edge.to]) {
-                dfsForComponents(edge.to, visited);
-            }
+    //метод для нахождения минимального остовного дерева (леса, если граф несвязный) алгоритмом Борувки
+    SpanningForestResult findMinimumSpanningTree() const {
+        static_assert(INT_WEIGHTS, "остовный лес строится только для весов int");
+        PERF_PHASE("spanning-forest");
+        SpanningForestResult forest = algo::findMinimumSpanningTree(*this);
+        if (!isDirected()) {
+            forest.trees -= removedCount; //удалённые вершины - одиночные деревья
         }
+        return forest;
     }
-    //метод для нахождения минимального остовного дерева с помощью алгоритма Прима
-    void findMinimumSpanningTree() {
-        if (directed) {
-            cout << "Алгоритм Прима применим только к неориентированным графам." << endl;
-            return;
-        }
-
-        vector<bool> inMST(numVertices, false);  //массив для отслеживания вершин в остовном дереве
-        vector<int> minEdgeWeight(numVertices, INT_MAX);  //минимальный вес для добавления каждой вершины
-        vector<int> parent(numVertices, -1);  //массив для хранения родителей в мин. ост. дереве
-
-        //приоритетная очередь для выбора минимального веса рёбра
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> pq;
 
-        int start = 0;  //начинаем с вершины с индексом 0
-        minEdgeWeight[start] = 0;
-        pq.push({ 0, start });  //помещаем начальную вершину в очередь
-
-        while (!pq.empty()) {
-            int u = pq.top().second;  //извлекаем вершину с минимальным весом
-            pq.pop();
-
-            if (inMST[u]) continue;  //пропускаем, если вершина уже в МОС
-
-            inMST[u] = true;  //добавляем вершину в МОС
-
-            //обходим все смежные вершины
-            for (const Edge& edge : adjList[u]) {
-                int v = edge.to;
-                int weight = edge.weight;
-
-                //если вершина v ещё не в МОС и вес ребра меньше известного
-                if (!inMST[v] && weight < minEdgeWeight[v]) {
-                    minEdgeWeight[v] = weight;
-                    pq.push({ weight, v });
-                    parent[v] = u;  //обновляем родителя вершины
-                }
-            }
-        }
+    //кратчайший путь алгоритмом Дейкстры; если вершины нет или путь не найден, found == false
+    //дерево кратчайших путей от начальной вершины берётся из кэша, пока граф не изменился
+    PathResultType findShortestPathDijkstra(const string& u, const string& v) const {
+        PERF_PHASE("dijkstra");
+        int start = names.find(u);
+        int end = names.find(v);
+        if (start == -1 || end == -1) {
+            return PathResultType();
+        }
+        //полное дерево считается и кэшируется только для повторяющихся начальных вершин,
+        //одиночный запрос останавливается на цели
+        shared_ptr<const ShortestPathTreeType> tree = pathCache->findTree(version, start);
+        if (!tree && pathCache->isRepeatedMiss(version, start)) {
+            tree = buildShortestPathTree(start);
+        }
+        if (!tree) {
+            return BasicDijkstraEngine<WeightT>::local().findPath(*this, start, end);
+        }
+        PathResultType result;
+        if (tree->distance[end] == BasicDijkstraEngine<WeightT>::UNREACHED) {
+            return result;
+        }
+        result.found = true;
+        result.distance = tree->distance[end];
+        //сначала длина пути, потом заполнение с конца: одно выделение памяти под точный размер
+        size_t length = 0;
+        for (int vertex = end; vertex != -1; vertex = tree->predecessor[vertex]) {
+            ++length;
+        }
+        result.vertices.resize(length);
+        for (int vertex = end; vertex != -1; vertex = tree->predecessor[vertex]) {
+            result.vertices[--length] = vertex;
+        }
+        return result;
+    }
 
-        //вывод минимального остовного дерева
-        cout << "Минимальное остовное дерево:" << endl;
-        int totalWeight = 0;
-        for (int i = 1; i < numVertices; ++i) {
-            if (parent[i] != -1) {
-                cout << indexToName[parent[i]] << " - " << indexToName[i] << " (вес: " << minEdgeWeight[i] << ")" << endl;
-                totalWeight += minEdgeWeight[i];
-            }
+    //полное дерево кратчайших путей (Дейкстра) от вершины start с кэшированием по версии графа
+    shared_ptr<const ShortestPathTreeType> getShortestPathTree(int start) const {
+        shared_ptr<const ShortestPathTreeType> cached = pathCache->findTree(version, start);
+        if (cached) {
+            return cached;
         }
-        cout << "Общий вес остовного дерева: " << totalWeight << endl;
+        return buildShortestPathTree(start);
     }
-    void findShortestPathDijkstra(const string& u, const string& v) {
-        if (nameToIndex.find(u) == nameToIndex.end() || nameToIndex.find(v) == nameToIndex.end()) {
-            cout << "Одна или обе вершины не существуют!" << endl;
-            return;
-        }
-
-        int start = nameToIndex[u]; //индекс начальной вершины
-        int end = nameToIndex[v];   //индекс конечной вершины
-
-        vector<int> distance(numVertices, INT_MAX); //минимальные расстояния до каждой вершины
-        vector<int> predecessor(numVertices, -1);   //предшественники для восстановления пути
 
-        //приоритетная очередь для выбора вершины с минимальным расстоянием
-        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> pq;
-
-        //инициализация начальной вершины
-        distance[start] = 0;
-        pq.emplace(0, start); //(расстояние, вершина)
-
-        while (!pq.empty()) {
-            //получаем пару (расстояние, вершина) из очереди
-            pair<int, int> top = pq.top();
-            pq.pop();
-
-            int dist = top.first;
-            int u = top.second;
+    //матрица кратчайших расстояний между всеми парами вершин с кэшированием по версии графа
+    shared_ptr<const AllPairsShortestPaths> getAllPairsShortestPaths() const {
+        static_assert(INT_WEIGHTS, "матрица всех пар строится только для весов int");
+        shared_ptr<const AllPairsShortestPaths> cached = pathCache->findMatrix(version);
+        if (cached) {
+            return cached;
+        }
+        PERF_PHASE("floyd-warshall");
+        auto paths = make_shared<const AllPairsShortestPaths>(*this);
+        pathCache->storeMatrix(version, paths);
+        return paths;
+    }
 
-            //если расстояние из очереди больше текущего, пропускаем
-            if (dist > distance[u]) continue;
+    //ёмкость кэша деревьев кратчайших путей (0 - не кэшировать)
+    void setPathCacheCapacity(size_t capacity) {
+        pathCache->setCapacity(capacity);
+    }
+    PathCacheStats getPathCacheStats() const {
+        return pathCache->getStats();
+    }
+    uint64_t getVersion() const {
+        return version;
+    }
 
-            //рассматриваем всех соседей текущей вершины
-            for (const Edge& edge : adjList[u]) {
-                int v = edge.to;
-                int weight = edge.weight;
 
-                //если найден более короткий путь, обновляем
-                if (distance[u] + weight < distance[v]) {
-                    distance[v] = distance[u] + weight;
-                    predecessor[v] = u;
-                    pq.emplace(distance[v], v); //добавляем обновлённое расстояние в очередь
-                }
-            }
+    //кратчайший путь двунаправленным алгоритмом Дейкстры (встречные поиски от u и от v по обратному графу)
+    PathResultType findShortestPathBidirectional(const string& u, const string& v) const {
+        PERF_PHASE("bidirectional-dijkstra");
+        int start = names.find(u);
+        int end = names.find(v);
+        if (start == -1 || end == -1) {
+            return PathResultType();
         }
+        return BasicBidirectionalDijkstra<WeightT>::local().findPath(*this, reverseView(), start, end);
+    }
 
-        //если конечная вершина недостижима
-        if (distance[end] == INT_MAX) {
-            cout << "Вершина " << v << " недостижима из " << u << "." << endl;
-            return;
-        }
+    //ориентиры для findShortestPathAlt: count вершин, расстояния от них и до них
+    LandmarkIndex buildLandmarkIndex(int count) const {
+        static_assert(INT_WEIGHTS, "ориентиры ALT работает только с весами int");
+        PERF_PHASE("landmarks");
+        return LandmarkIndex(*this, reverseView(), count, removedCount > 0 ? &removed : nullptr);
+    }
 
-        //восстанавливаем путь от u до v
-        vector<string> path;
-        for (int current = end; current != -1; current = predecessor[current]) {
-            path.push_back(indexToName[current]);
+    //кратчайший путь поиском A* с потенциалами по ориентирам (ALT); индекс должен быть построен для текущего графа
+    PathResult findShortestPathAlt(const LandmarkIndex& landmarks, const string& u, const string& v) const {
+        static_assert(INT_WEIGHTS, "поиск ALT работает только с весами int");
+        PERF_PHASE("alt");
+        if (landmarks.getNumVertices() != numVertices) {
+            throw runtime_error("Индекс ориентиров построен для другого графа!");
         }
-        reverse(path.begin(), path.end());
-
-        //вывод результата
-        cout << "Кратчайший путь из " << u << " в " << v << ": ";
-        for (const string& vertex : path) {
-            cout << vertex << " ";
+        int start = names.find(u);
+        int end = names.find(v);
+        if (start == -1 || end == -1) {
+            return PathResult();
         }
-        cout << endl;
-        cout << "Длина пути: " << distance[end] << endl;
+        return DijkstraEngine::local().findPathAStar(*this, start, end, [&](int vertex) { return landmarks.lowerBound(vertex, end); });
     }
 
 
-    //определить, существует ли путь длиной не более L между двумя заданными вершинами графа с помощью алгоритма Флойда — Уоршелла
-    void findPathWithinL(const string& startName, const string& endName, int L) {
-        //проверяем, существуют ли начальная и конечная вершины
-        if (nameToIndex.find(startName) == nameToIndex.end() || nameToIndex.find(endName) == nameToIndex.end()) {
-            cout << "Одна или обе вершины не существуют!" << endl;
-            return; 
-        }
-
-        //индексы для вершин
-        int start = nameToIndex[startName];
-        int end = nameToIndex[endName];
-        int n = adjList.size();
-        const int INF = INT_MAX / 2; //бесконечность для недостижимых путей
-
-        //инициализация матрицы расстояний и матрицы "предков" для восстановления пути
-        vector<vector<int>> dist(n, vector<int>(n, INF));
-        vector<vector<int>> next(n, vector<int>(n, -1)); //матрица для восстановления пути
-
-        //список всех вершин
-        vector<string> vertices;
-        for (const auto& pair : nameToIndex) {
-            vertices.push_back(pair.first); 
-        }
+    //иерархия сжатий для findShortestPathCH (предобработка; веса рёбер должны быть неотрицательными)
+    ContractionHierarchy buildContractionHierarchy() const {
+        static_assert(INT_WEIGHTS, "иерархия сжатий работает только с весами int");
+        PERF_PHASE("contraction-hierarchy");
+        return ContractionHierarchy(*this);
+    }
 
-        //заполнение списков расстояний и связей для прямых рёбер
-        for (int i = 0; i < n; ++i) {
-            dist[i][i] = 0; // Расстояние до себя = 0
-            for (const Edge& edge : adjList[i]) {
-                dist[i][edge.to] = edge.weight; //вес ребра
-                next[i][edge.to] = edge.to;    //связь с другими ребрами ребро
-            }
+    //кратчайший путь по иерархии сжатий, построенной (или загруженной из файла) для текущего графа
+    PathResult findShortestPathCH(const ContractionHierarchy& hierarchy, const string& u, const string& v) const {
+        static_assert(INT_WEIGHTS, "иерархия сжатий работает только с весами int");
+        PERF_PHASE("ch-query");
+        if (hierarchy.getNumVertices() != numVertices) {
+            throw runtime_error("Иерархия сжатий построена для другого графа!");
         }
-
-        //алгоритм Флойда-Уоршелла для нахождения всех кратчайших путей
-        for (int k = 0; k < n; ++k) {
-            for (int i = 0; i < n; ++i) {
-                for (int j = 0; j < n; ++j) {
-                    if (dist[i][k] < INF && dist[k][j] < INF) {
-                        if (dist[i][j] > dist[i][k] + dist[k][j]) {
-                            dist[i][j] = dist[i][k] + dist[k][j];
-                            next[i][j] = next[i][k]; 
-                        }
-                    }
-                }
-            }
+        int start = names.find(u);
+        int end = names.find(v);
+        if (start == -1 || end == -1) {
+            return PathResult();
         }
+        return hierarchy.findPath(start, end);
+    }
 
-        //проверяем, что существует ли путь с длиной <= L
-        if (dist[start][end] > L || dist[start][end] == INF) {
-            cout << "Путь не существует или его длина больше, чем " << L << endl;
-            return;
-        }
 
-        //восстанавливаем путь
-        vector<string> path;
-        int current = start;
-        while (current != end) {
-            if (current == -1) {
-                cout << "Путь недостижим!" << endl;
-                return; 
-            }
-            path.push_back(vertices[current]); //добавляем название вершины в путь
-            current = next[current][end];
+    //путь длиной не более L между двумя вершинами по матрице кратчайших расстояний (Флойд-Уоршелл);
+    //found == false, если вершины нет, пути нет или кратчайший путь длиннее L
+    PathResult findPathWithinL(const string& startName, const string& endName, int L) const {
+        static_assert(INT_WEIGHTS, "Флойд-Уоршелл работает только с весами int");
+        PERF_PHASE("path-within-l");
+        int start = names.find(startName);
+        int end = names.find(endName);
+        if (start == -1 || end == -1) {
+            return PathResult();
         }
-        path.push_back(vertices[end]); //добавляем конечную вершину в путь
 
-        
-        cout << "Путь от " << startName << " до " << endName << " с длиной <= " << L << "\n";
-        cout << "Минимальная длина пути : " << dist[start][end] << "\n";
-        for (const string& vertex : path) {
-            cout << vertex << " "; 
+        //кратчайшие расстояния между всеми парами вершин (блочный Флойд-Уоршелл, из кэша до изменения графа)
+        shared_ptr<const AllPairsShortestPaths> paths = getAllPairsShortestPaths();
+        int distance = paths->getDistance(start, end);
+        if (distance > L || distance >= AllPairsShortestPaths::INF) {
+            return PathResult();
         }
-        cout << endl;
+        return paths->getPath(start, end);
     }
    
-    //метод для проверки вершины, удовлетворяющей условию задачи
-    vector<int> getVerticesWithPathsBelowN(int N) {
-        vector<int> validVertices; //список для хранения вершин, которые удовлетворяют условию.
-
-        for (int u = 0; u < numVertices; ++u) {
-            vector<int> distance(numVertices, INT_MAX);
-            distance[u] = 0;
-
-            //алгоритм Беллмана-Форда
-            for (int i = 0; i < numVertices - 1; ++i) {
-                for (int v = 0; v < numVertices; ++v) {
-                    for (const Edge& edge : adjList[v]) {
-                        if (distance[v] != INT_MAX && distance[v] + edge.weight < distance[edge.to]) {
-                            distance[edge.to] = distance[v] + edge.weight;
-                        }
-                    }
-                }
-            }
-            //проверка на отрицательный цикл
-            bool hasNegativeCycle = false;
-            for (int v = 0; v < numVertices; ++v) {
-                for (const Edge& edge : adjList[v]) {
-                    if (distance[v] != INT_MAX && distance[v] + edge.weight < distance[edge.to]) {
-                        hasNegativeCycle = true;
-                        break;
-                    }
-                }
-            }
-            if (hasNegativeCycle) {
-                cout << "Граф содержит отрицательный цикл. Проверка невозможна." << endl;
-                return {};
-            }
-            //проверяем все минимальные расстояния от вершины u
-            bool allBelowN = true;
-            for (int v = 0; v < numVertices; ++v) {
-                if (v != u && (distance[v] == INT_MAX || distance[v] > N)) {
-                    allBelowN = false;
-                    break;
-                }
-            }
-
-            //если вершина удовлетворяет условию, добавляем ее в список
-            if (allBelowN) {
-                validVertices.push_back(u);
-            }
-        }
-        if (!validVertices.empty()) {
-            cout << "Вершины, удовлетворяющие условию (расстояния не превосходят " << N << "): ";
-            for (int vertex : validVertices) {
-                cout << indexToName[vertex] << " ";
-            }
-            cout << endl;
-        }
-        else {
-            cout << "В графе нет вершин, удовлетворяющих условию." << endl;
-        }
-
-        return validVertices;
+    //вершины, от которых кратчайшие расстояния до всех остальных вершин не превосходят N
+    VerticesBelowNResult getVerticesWithPathsBelowN(int N) const {
+        static_assert(INT_WEIGHTS, "проверка N работает только с весами int");
+        PERF_PHASE("paths-below-n");
+        return algo::getVerticesWithPathsBelowN(*this, N, removedCount > 0 ? &removed : nullptr);
     }
 
-    //вспомогательный метод для поиска пути в остаточной сети с использованием BFS
-    bool bfs(vector<vector<int>>& residualGraph, int source, int sink, vector<int>& parent) {
-        int n = residualGraph.size();
-        vector<bool> visited(n, false);
-
-        queue<int> q;
-        q.push(source);
-        visited[source] = true;
-        parent[source] = -1;
-
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
-
-            for (int v = 0; v < n; ++v) {
-                if (!visited[v] && residualGraph[u][v] > 0) {
-                    q.push(v);
-                    parent[v] = u;
-                    visited[v] = true;
-
-                    if (v == sink) {
-                        return true;
-                    }
-                }
-            }
-        }
-
-        return false;
-    }
-
-    int fordFulkerson(const string& u, const string& v) {
-        if (nameToIndex.find(u) == nameToIndex.end() || nameToIndex.find(v) == nameToIndex.end()) {
+    //максимальный поток из u в v (веса рёбер - пропускные способности) алгоритмом Диница
+    //при подключённом приёмнике трассировки после каждой фазы передаётся остаточная сеть
+    MaxFlowResult fordFulkerson(const string& u, const string& v) const {
+        static_assert(is_integral_v<WeightT>, "пропускные способности должны быть целыми");
+        PERF_PHASE("max-flow");
+        int source = names.find(u);
+        int sink = names.find(v);
+        if (source == -1 || sink == -1) {
             throw runtime_error("Начальная вершина или конечная вершина не найдена!");
         }
 
-        int source = nameToIndex[u];
-        int sink = nameToIndex[v];
-
-        int n = numVertices;
-        vector<vector<int>> residualGraph(n, vector<int>(n, 0)); //матрица остаточной сети nxn (n-кол-во вершин)
-
-        //строим остаточную сеть из списка смежности графа
-        for (int u = 0; u < n; ++u) {
-            for (const Edge& edge : adjList[u]) {
-                residualGraph[u][edge.to] = edge.weight;
+        //остаточная сеть: каждое ребро списка смежности со своим обратным ребром
+        MaxFlowEngine network(numVertices);
+        network.reserve(numArcs);
+        for (int from = 0; from < numVertices; ++from) {
+            for (const EdgeType& edge : adjList[from]) {
+                network.addEdge(from, edge.to, edge.weight);
             }
         }
 
-        vector<int> parent(n);
-        int maxFlow = 0;
-
-        //пока существует путь от source до sink в остаточной сети
-        while (bfs(residualGraph, source, sink, parent)) {
-            // Находим минимальный поток на найденном пути
-            int pathFlow = numeric_limits<int>::max();
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                pathFlow = min(pathFlow, residualGraph[u][v]);
-            }
-
-            // Обновляем остаточную сеть
-            for (int v = sink; v != source; v = parent[v]) {
-                int u = parent[v];
-                residualGraph[u][v] -= pathFlow;
-                residualGraph[v][u] += pathFlow;
+        MaxFlowResult result;
+        TraceSink* trace = traceSink;
+        result.flow = network.maxFlow(source, sink, LLONG_MAX, [&](int phase, long long flow) {
+            result.phases = phase;
+            if (!trace) {
+                return;
             }
-
-            maxFlow += pathFlow;
-
-            // Добавляем вывод остаточной сети здесь
-            cout << "Остаточный граф после итерации" << endl;
-            for (int i = 0; i < n; ++i) {
-                for (int j = 0; j < n; ++j) {
-                    cout << residualGraph[i][j] << " ";
+            trace->trace("Остаточная сеть после фазы " + to_string(phase) + " (поток " + to_string(flow) + ")");
+            for (int id = 0; id < network.getNumArcs(); ++id) {
+                if (network.getResidualCapacity(id) > 0) {
+                    trace->trace(string(names[network.getArcFrom(id)]) + " -> " + string(names[network.getArcTo(id)])
+                        + ": " + to_string(network.getResidualCapacity(id)));
                 }
-                cout << endl;
             }
-        }
-
+        });
+        return result;
+    }
 
-        return maxFlow;
+    //подключает приёмник трассировки (nullptr - отключить); приёмник должен жить дольше запросов
+    void setTraceSink(TraceSink* sink) {
+        traceSink = sink;
+    }
+    TraceSink* getTraceSink() const {
+        return traceSink;
     }
 
 
@@ -763,22 +1067,69 @@ public:
     //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+    //размер нумерации: до уплотнения вместе с удалёнными вершинами (у них нет рёбер и имени в таблице)
     int getNumVertices() const {
         return numVertices;
     }
-    string getVertexName(int index) const {
+    bool isRemoved(int index) const {
+        return removed[index] != 0;
+    }
+    string_view getVertexName(int index) const {
         if (index >= 0 && index < numVertices) {
-            return indexToName.at(index);
+            return names[index];
         }
         throw runtime_error("Некорректный индекс вершины");
     }
-    const vector<Edge>& getAdjList(int index) const {
+    const VertexNames& getVertexNames() const {
+        return names;
+    }
+    //индекс вершины по имени или -1, если вершины нет
+    int findVertex(const string& name) const {
+        return names.find(name);
+    }
+    //соседи вершины без проверки индекса (для алгоритмов; индекс берётся после getNumVertices() или findVertex())
+    const EdgeList& neighbors(int index) const {
+        return adjList[index];
+    }
+    //входящие рёбра вершины без проверки индекса, edge.to - начало ребра
+    const EdgeList& reverseNeighbors(int index) const {
+        return isDirected() ? reverseAdjList[index] : adjList[index];
+    }
+
+    //обратный граф без копирования: те же вершины и имена, рёбра - входящие рёбра графа
+    //подходит всем обратным поискам (двунаправленная Дейкстра, ориентиры, достижимость через algo::)
+    //действителен, пока граф не меняется
+    class ReverseView {
+    private:
+        const BasicGraph* graph;
+    public:
+        explicit ReverseView(const BasicGraph& graph) : graph(&graph) {}
+        int getNumVertices() const {
+            return graph->getNumVertices();
+        }
+        bool isDirected() const {
+            return graph->isDirected();
+        }
+        const EdgeList& neighbors(int index) const {
+            return graph->reverseNeighbors(index);
+        }
+        int findVertex(const string& name) const {
+            return graph->findVertex(name);
+        }
+        string_view getVertexName(int index) const {
+            return graph->getVertexName(index);
+        }
+    };
+    ReverseView reverseView() const {
+        return ReverseView(*this);
+    }
+    const EdgeList& getAdjList(int index) const {
         if (index >= 0 && index < numVertices) {
             return adjList[index];
         }
         throw runtime_error("Некорректный индекс вершины");
     }
-    void visualizeGraph(Graph& graph) {
+    void visualizeGraph(BasicGraph& graph) {
         sf::RenderWindow window(sf::VideoMode(1000, 800), "Graph Visualization");
 
         std::unordered_map<int, sf::CircleShape> vertexShapes;
@@ -797,7 +1148,9 @@ public:
         float radius = 300.0f; 
 
         for (int i = 0; i < graph.getNumVertices(); ++i) {
-           
+            if (graph.isRemoved(i)) {
+                continue;
+            }
             float angle = i * angleIncrement;
             float x = 500 + radius * cos(angle * 3.14f / 180);
             float y = 400 + radius * sin(angle * 3.14f / 180);
@@ -811,7 +1164,7 @@ public:
             
             sf::Text label;
             label.setFont(font);
-            label.setString(graph.getVertexName(i));
+            label.setString(string(graph.getVertexName(i)));
             label.setCharacterSize(18);
             label.setFillColor(sf::Color::Black);
 
@@ -834,7 +1187,7 @@ public:
             arrows.clear(); 
 
             for (int u = 0; u < graph.getNumVertices(); ++u) {
-                for (const Edge& edge : graph.getAdjList(u)) {
+                for (const EdgeType& edge : graph.getAdjList(u)) {
                     int v = edge.to;
                     if (!graph.isDirected() && u > v) {
                         continue;
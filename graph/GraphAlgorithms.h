@@ -0,0 +1,201 @@
+﻿#ifndef GRAPH_ALGORITHMS_H
+#define GRAPH_ALGORITHMS_H
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <queue>
+#include <climits>
+#include "GraphResults.h"
+#include "DijkstraEngine.h"
+#include "ThreadPool.h"
+#include "Traversal.h"
+#include "Edge.h"
+#include "MaxFlow.h"
+#include "SpanningForest.h"
+#include "PerfCounters.h"
+using namespace std;
+
+//общие реализации алгоритмов для Graph и CsrGraph
+//от графа требуется: getNumVertices(), isDirected(), neighbors(u), findVertex(name), getVertexName(index)
+namespace algo {
+
+    //функция проверки существования пути между двумя вершинами
+    template <class G>
+    bool hasPath(const G& graph, int u, int v) {
+        return TraversalEngine::local().hasPath(graph, u, v);
+    }
+
+    //кол-во компонент связности (для ориентированного графа - число корней обхода по порядку вершин)
+    template <class G>
+    int countConnectedComponents(const G& graph) {
+        return TraversalEngine::local().countComponents(graph);
+    }
+
+    //минимальный остовный лес (параллельный алгоритм Борувки); для ориентированного графа - пустой результат
+    template <class G>
+    SpanningForestResult findMinimumSpanningTree(const G& graph) {
+        if (graph.isDirected()) {
+            return SpanningForestResult();
+        }
+        return findMinimumSpanningForest(graph);
+    }
+
+    //кратчайший путь между двумя вершинами алгоритмом Дейкстры, поиск останавливается на конечной вершине
+    template <class G>
+    PathResult findShortestPathDijkstra(const G& graph, const string& u, const string& v) {
+        int start = graph.findVertex(u); //индекс начальной вершины
+        int end = graph.findVertex(v);   //индекс конечной вершины
+        if (start == -1 || end == -1) {
+            return PathResult();
+        }
+        //буферы движка потока переиспользуются между запросами
+        return DijkstraEngine::local().findPath(graph, start, end);
+    }
+
+    //потенциалы Джонсона: кратчайшие расстояния от фиктивной вершины, соединённой со всеми вершинами рёбрами веса 0
+    //(алгоритм Беллмана-Форда с остановкой, когда проход ничего не изменил); false, если есть отрицательный цикл
+    template <class G>
+    bool findJohnsonPotentials(const G& graph, vector<int>& potential) {
+        int numVertices = graph.getNumVertices();
+        potential.assign(numVertices, 0);
+        for (int pass = 0; pass <= numVertices; ++pass) {
+            PERF_COUNT(RelaxationPasses, 1);
+            bool changed = false;
+            for (int v = 0; v < numVertices; ++v) {
+                for (const auto& edge : graph.neighbors(v)) {
+                    if (potential[v] + edge.weight < potential[edge.to]) {
+                        potential[edge.to] = potential[v] + edge.weight;
+                        changed = true;
+                    }
+                }
+            }
+            if (!changed) {
+                return true;
+            }
+        }
+        return false; //изменения после V проходов возможны только при отрицательном цикле
+    }
+
+    //вершины, от которых кратчайшие расстояния до всех остальных вершин не превосходят N
+    //одна проверка на отрицательный цикл, перевзвешивание по Джонсону и Дейкстра из каждой вершины
+    //параллельно на пуле потоков; поиск из вершины прекращается на первом расстоянии больше N
+    //removed - отметки удалённых (изолированных) вершин, которые не участвуют в проверке
+    template <class G>
+    VerticesBelowNResult getVerticesWithPathsBelowN(const G& graph, int N, const vector<char>* removed = nullptr,
+        ThreadPool& pool = ThreadPool::shared()) {
+        VerticesBelowNResult result;
+        int numVertices = graph.getNumVertices();
+        int liveVertices = numVertices;
+        if (removed) {
+            liveVertices -= (int)count(removed->begin(), removed->end(), 1);
+        }
+
+        bool hasNegativeEdges = false;
+        for (int v = 0; v < numVertices && !hasNegativeEdges; ++v) {
+            for (const auto& edge : graph.neighbors(v)) {
+                if (edge.weight < 0) {
+                    hasNegativeEdges = true;
+                    break;
+                }
+            }
+        }
+
+        //перевзвешенный граф: w'(a, b) = w(a, b) + h(a) - h(b) >= 0
+        vector<int> potential(numVertices, 0);
+        if (hasNegativeEdges && !findJohnsonPotentials(graph, potential)) {
+            result.negativeCycle = true;
+            return result;
+        }
+        CsrAdjacency reweighted = CsrAdjacency::from(graph);
+        for (int v = 0; v < numVertices; ++v) {
+            for (int i = reweighted.offsets[v]; i < reweighted.offsets[v + 1]; ++i) {
+                reweighted.weights[i] += potential[v] - potential[reweighted.targets[i]];
+            }
+        }
+
+        vector<char> valid(numVertices, 0);
+        vector<DijkstraEngine> engines(pool.size()); //у каждого исполнителя свой рабочий буфер
+        pool.parallelFor(numVertices, [&](int worker, int u) {
+            if (removed && (*removed)[u]) {
+                return;
+            }
+            int settled = 0;
+            bool allBelowN = true;
+            engines[worker].searchFrom(reweighted, u, [&](int v, int dist) {
+                ++settled;
+                //настоящее расстояние d(u, v) = d'(u, v) - h(u) + h(v)
+                if ((long long)dist - potential[u] + potential[v] > N) {
+                    allBelowN = false;
+                    return false;
+                }
+                return true;
+            });
+            valid[u] = allBelowN && settled == liveVertices;
+        });
+
+        for (int u = 0; u < numVertices; ++u) {
+            if (valid[u]) {
+                result.vertices.push_back(u);
+            }
+        }
+        return result;
+    }
+
+    //минимальный рёберный разрез между source и sink: поток единичной пропускной способности
+    //по остаточной сети, поиск останавливается на k + 1 рёберно-непересекающихся путях,
+    //поэтому работа ограничена O(k * E) независимо от настоящей связности
+    //treatAsDirected == false - рёбра ориентированного графа считаются неориентированными
+    template <class G>
+    EdgeCutResult findEdgeCut(const G& graph, int source, int sink, int k, bool treatAsDirected) {
+        EdgeCutResult result;
+        if (source == sink) {
+            result.connectivity = max(k, 0) + 1; //вершину нельзя отделить от самой себя
+            return result;
+        }
+
+        int numVertices = graph.getNumVertices();
+        MaxFlowEngine network(numVertices);
+        //в неориентированном графе ребро уже записано в обоих списках смежности
+        bool addReverse = graph.isDirected() && !treatAsDirected;
+        size_t numArcs = 0;
+        for (int from = 0; from < numVertices; ++from) {
+            numArcs += graph.neighbors(from).size();
+        }
+        network.reserve(addReverse ? numArcs * 2 : numArcs);
+        //ребро графа для каждого ребра сети: встречное ребро сети отвечает тому же ребру графа
+        vector<pair<int, int>> original;
+        original.reserve(addReverse ? numArcs * 2 : numArcs);
+        for (int from = 0; from < numVertices; ++from) {
+            for (const auto& edge : graph.neighbors(from)) {
+                network.addEdge(from, edge.to, 1);
+                original.push_back({ from, (int)edge.to });
+                if (addReverse) {
+                    network.addEdge(edge.to, from, 1);
+                    original.push_back({ from, (int)edge.to });
+                }
+            }
+        }
+
+        long long limit = (long long)max(k, 0) + 1;
+        result.connectivity = (int)network.maxFlow(source, sink, limit);
+        result.alreadyDisconnected = result.connectivity == 0;
+        result.possible = result.connectivity <= k || result.alreadyDisconnected;
+        if (!result.possible || result.alreadyDisconnected) {
+            return result;
+        }
+
+        //рёбра из достижимой по остаточной сети части в недостижимую (прямые рёбра имеют чётные номера);
+        //в ответ идёт ребро графа в его собственном направлении, а не направление ребра сети
+        vector<char> side = network.sourceSide(source);
+        for (int id = 0; id < network.getNumArcs(); id += 2) {
+            if (side[network.getArcFrom(id)] && !side[network.getArcTo(id)]) {
+                result.cutEdges.push_back(original[id / 2]);
+            }
+        }
+        return result;
+    }
+}
+
+#endif  // GRAPH_ALGORITHMS_H
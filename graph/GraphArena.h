@@ -0,0 +1,88 @@
+﻿#ifndef GRAPH_ARENA_H
+#define GRAPH_ARENA_H
+#include <memory_resource>
+#include <cstddef>
+using namespace std;
+
+//арена для хранения графа (списки смежности и байты имён), подключается через pmr::memory_resource
+//блоки одного размера переиспользуются пулами (рост списков при addEdge не оставляет дыр),
+//пулы и крупные списки берут память подряд из монотонной арены; освобождение отдельного списка
+//возвращает блок в пул, а вся память отдаётся системе одним release() или в деструкторе
+//не потокобезопасна: граф, построенный на арене, меняют из одного потока (запросы только читают)
+//арена должна жить дольше графа
+class GraphArena : public pmr::memory_resource {
+private:
+    //считает память, взятую у системы
+    class CountingResource : public pmr::memory_resource {
+    private:
+        pmr::memory_resource* upstream;
+        size_t held = 0;
+
+    public:
+        explicit CountingResource(pmr::memory_resource* upstream) : upstream(upstream) {}
+
+        size_t getHeld() const {
+            return held;
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            void* block = upstream->allocate(bytes, alignment);
+            held += bytes;
+            return block;
+        }
+        void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+            upstream->deallocate(block, bytes, alignment);
+            held -= bytes;
+        }
+        bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    CountingResource system;
+    pmr::monotonic_buffer_resource chunks;       //крупные блоки подряд, освобождаются только все сразу
+    pmr::unsynchronized_pool_resource pools;     //блоки по размерам поверх chunks
+    size_t used = 0;                             //байт выдано контейнерам и ещё не освобождено
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* block = pools.allocate(bytes, alignment);
+        used += bytes;
+        return block;
+    }
+    void do_deallocate(void* block, size_t bytes, size_t alignment) override {
+        pools.deallocate(block, bytes, alignment);
+        used -= bytes;
+    }
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    static constexpr size_t INITIAL_CHUNK = 1 << 20;
+
+    explicit GraphArena(size_t initialChunk = INITIAL_CHUNK, pmr::memory_resource* upstream = pmr::new_delete_resource())
+        : system(upstream), chunks(initialChunk, &system), pools(&chunks) {}
+
+    GraphArena(const GraphArena&) = delete;
+    GraphArena& operator=(const GraphArena&) = delete;
+
+    //байт, взятых у системы (включая свободные блоки пулов и остаток текущего блока арены)
+    size_t getBytesHeld() const {
+        return system.getHeld();
+    }
+
+    //байт в контейнерах, которые ещё живы
+    size_t getBytesUsed() const {
+        return used;
+    }
+
+    //возвращает системе всю память сразу; контейнеры на арене к этому моменту должны быть уничтожены
+    void release() {
+        pools.release();
+        chunks.release();
+        used = 0;
+    }
+};
+
+#endif  // GRAPH_ARENA_H
@@ -0,0 +1,17 @@
+﻿#ifndef GRAPH_FWD_H
+#define GRAPH_FWD_H
+
+//ориентированность графа: задана в типе или хранится в объекте (Runtime - тип графа читается из файла)
+enum class Directedness {
+    Undirected,
+    Directed,
+    Runtime
+};
+
+template <class WeightT, class IndexT, Directedness D>
+class BasicGraph;
+
+//граф приложения: веса и номера int, ориентированность из файла или меню
+using Graph = BasicGraph<int, int, Directedness::Runtime>;
+
+#endif  // GRAPH_FWD_H
@@ -0,0 +1,236 @@
+﻿#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+//детерминированные генераторы синтетических графов для замеров производительности
+//рёбра задаются номерами вершин, вершина i в файле называется "v<i>"
+namespace gen {
+
+    //генератор псевдослучайных чисел splitmix64: одинаковая последовательность на любой платформе
+    //(в отличие от распределений стандартной библиотеки)
+    class Random {
+    private:
+        uint64_t state;
+
+    public:
+        explicit Random(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        //число в [0, bound)
+        int below(int bound) {
+            return (int)(next() % (uint64_t)bound);
+        }
+
+        //число в [low, high]
+        int between(int low, int high) {
+            return low + below(high - low + 1);
+        }
+
+        //число в [0, 1)
+        double unit() {
+            return (next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+    };
+
+    struct GeneratedEdge {
+        int from;
+        int to;
+        int weight;
+    };
+
+    //синтетический граф: рёбра (в неориентированном графе - по одному разу) и номера вершин для запросов
+    struct GeneratedGraph {
+        string kind;
+        bool directed = false;
+        int numVertices = 0;
+        vector<GeneratedEdge> edges;
+        int source = 0;                          //вершины для запросов пути и потока
+        int sink = 0;
+
+        //сохраняет граф в текстовом формате Graph
+        void writeEdgeList(const string& filename) const {
+            ofstream out(filename);
+            if (!out) {
+                throw runtime_error("Ошибка открытия файла для записи!");
+            }
+            out << (directed ? "Directed\n" : "Undirected\n");
+            for (const GeneratedEdge& edge : edges) {
+                out << 'v' << edge.from << " v" << edge.to << ' ' << edge.weight << '\n';
+            }
+            if (!out) {
+                throw runtime_error("Ошибка записи графа в файл " + filename);
+            }
+        }
+    };
+
+    //случайный граф Эрдёша-Реньи G(n, m): m рёбер между случайными парами различных вершин
+    inline GeneratedGraph erdosRenyi(int numVertices, size_t numEdges, bool directed, uint64_t seed) {
+        Random random(seed);
+        GeneratedGraph graph;
+        graph.kind = "erdos-renyi";
+        graph.directed = directed;
+        graph.numVertices = numVertices;
+        graph.edges.reserve(numEdges);
+        while (graph.edges.size() < numEdges) {
+            int from = random.below(numVertices);
+            int to = random.below(numVertices);
+            if (from != to) {
+                graph.edges.push_back({ from, to, random.between(1, 100) });
+            }
+        }
+        graph.source = 0;
+        graph.sink = numVertices - 1;
+        return graph;
+    }
+
+    //R-MAT (степенное распределение степеней): каждое ребро - спуск по квадрантам матрицы смежности
+    //2^scale x 2^scale с вероятностями a, b, c и 1 - a - b - c
+    inline GeneratedGraph rmat(int scale, size_t numEdges, bool directed, uint64_t seed,
+        double a = 0.57, double b = 0.19, double c = 0.19) {
+        Random random(seed);
+        GeneratedGraph graph;
+        graph.kind = "rmat";
+        graph.directed = directed;
+        graph.numVertices = 1 << scale;
+        graph.edges.reserve(numEdges);
+        while (graph.edges.size() < numEdges) {
+            int from = 0;
+            int to = 0;
+            for (int bit = scale - 1; bit >= 0; --bit) {
+                double r = random.unit();
+                if (r >= a + b + c) {
+                    from |= 1 << bit;
+                    to |= 1 << bit;
+                }
+                else if (r >= a + b) {
+                    from |= 1 << bit;
+                }
+                else if (r >= a) {
+                    to |= 1 << bit;
+                }
+            }
+            if (from != to) {
+                graph.edges.push_back({ from, to, random.between(1, 100) });
+            }
+        }
+        graph.source = 0;                        //вершина 0 - самая плотная часть графа
+        graph.sink = graph.numVertices - 1;
+        return graph;
+    }
+
+    //неориентированная решётка width x height (похожа на дорожную сеть): рёбра к правому и нижнему соседу
+    inline GeneratedGraph grid(int width, int height, uint64_t seed) {
+        Random random(seed);
+        GeneratedGraph graph;
+        graph.kind = "grid";
+        graph.directed = false;
+        graph.numVertices = width * height;
+        graph.edges.reserve((size_t)2 * width * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int v = y * width + x;
+                if (x + 1 < width) {
+                    graph.edges.push_back({ v, v + 1, random.between(1, 100) });
+                }
+                if (y + 1 < height) {
+                    graph.edges.push_back({ v, v + width, random.between(1, 100) });
+                }
+            }
+        }
+        graph.source = 0;                        //противоположные углы
+        graph.sink = graph.numVertices - 1;
+        return graph;
+    }
+
+    //слоистая транспортная сеть: исток -> layers слоёв по width вершин -> сток,
+    //из каждой вершины слоя degree рёбер в случайные вершины следующего слоя
+    inline GeneratedGraph layeredFlow(int layers, int width, int degree, uint64_t seed) {
+        Random random(seed);
+        GeneratedGraph graph;
+        graph.kind = "layered-flow";
+        graph.directed = true;
+        graph.numVertices = layers * width + 2;
+        graph.source = 0;
+        graph.sink = graph.numVertices - 1;
+        auto vertex = [&](int layer, int i) { return 1 + layer * width + i; };
+        for (int i = 0; i < width; ++i) {
+            graph.edges.push_back({ graph.source, vertex(0, i), random.between(50, 100) });
+            graph.edges.push_back({ vertex(layers - 1, i), graph.sink, random.between(50, 100) });
+        }
+        for (int layer = 0; layer + 1 < layers; ++layer) {
+            for (int i = 0; i < width; ++i) {
+                for (int d = 0; d < degree; ++d) {
+                    graph.edges.push_back({ vertex(layer, i), vertex(layer + 1, random.below(width)), random.between(1, 100) });
+                }
+            }
+        }
+        return graph;
+    }
+
+    //ориентированная копия графа с отрицательными весами без отрицательных циклов (для Беллмана-Форда):
+    //вершинам даются случайные потенциалы p из [0, maxShift], вес ребра a -> b становится w + p(a) - p(b);
+    //длина любого цикла при этом не меняется, а неориентированное ребро превращается в два встречных
+    //(их сумма 2w > 0); при весах от 1 кратчайшие пути от фиктивной вершины не длиннее maxShift рёбер,
+    //поэтому Беллман-Форд делает не больше maxShift + 1 проходов
+    inline GeneratedGraph withNegativeWeights(const GeneratedGraph& graph, int maxShift, uint64_t seed) {
+        Random random(seed);
+        vector<int> shift(graph.numVertices);
+        for (int& p : shift) {
+            p = random.between(0, maxShift);
+        }
+        GeneratedGraph result;
+        result.kind = graph.kind;
+        result.directed = true;
+        result.numVertices = graph.numVertices;
+        result.source = graph.source;
+        result.sink = graph.sink;
+        result.edges.reserve(graph.directed ? graph.edges.size() : graph.edges.size() * 2);
+        for (const GeneratedEdge& edge : graph.edges) {
+            result.edges.push_back({ edge.from, edge.to, edge.weight + shift[edge.from] - shift[edge.to] });
+            if (!graph.directed) {
+                result.edges.push_back({ edge.to, edge.from, edge.weight + shift[edge.to] - shift[edge.from] });
+            }
+        }
+        return result;
+    }
+
+    //графы заданного вида примерно с numEdges рёбрами (средняя степень около 8);
+    //Эрдёш-Реньи и решётка неориентированные, R-MAT и слоистая сеть ориентированные
+    inline GeneratedGraph bySize(const string& kind, size_t numEdges, uint64_t seed) {
+        if (kind == "erdos-renyi") {
+            return erdosRenyi(max<int>(2, (int)(numEdges / 4)), numEdges, false, seed);
+        }
+        if (kind == "rmat") {
+            int scale = 1;
+            while (((size_t)1 << (scale + 2)) < numEdges) { //2^scale ~ numEdges / 4
+                ++scale;
+            }
+            return rmat(scale, numEdges, true, seed);
+        }
+        if (kind == "grid") {
+            int side = max(2, (int)sqrt((double)numEdges / 2));
+            return grid(side, side, seed);
+        }
+        if (kind == "layered-flow") {
+            int width = max(2, (int)sqrt((double)numEdges / 4));
+            int layers = max(2, (int)(numEdges / ((size_t)width * 4)));
+            return layeredFlow(layers, width, 4, seed);
+        }
+        throw runtime_error("Неизвестный вид графа: " + kind);
+    }
+}
+
+#endif  // GRAPH_GENERATORS_H
@@ -0,0 +1,58 @@
+﻿#ifndef GRAPH_RESULTS_H
+#define GRAPH_RESULTS_H
+#include <vector>
+#include <utility>
+using namespace std;
+
+//результаты алгоритмов: вычисления возвращают их, а вывод делает вызывающая сторона (меню)
+
+//кратчайший путь: длина и индексы вершин от начальной до конечной; DistanceT - тип длины (совпадает с типом веса)
+template <class DistanceT = int>
+struct BasicPathResult {
+    bool found = false;        //false, если вершины нет или конечная недостижима
+    DistanceT distance = 0;    //длина пути
+    vector<int> vertices;      //путь, начиная с начальной вершины
+};
+using PathResult = BasicPathResult<int>;
+
+//вершины, от которых кратчайшие расстояния до всех остальных вершин не превосходят N
+struct VerticesBelowNResult {
+    bool negativeCycle = false; //в графе есть отрицательный цикл, проверка невозможна
+    vector<int> vertices;       //подходящие вершины в порядке возрастания индекса
+};
+
+//можно ли разъединить две вершины, удалив не более k рёбер
+struct EdgeCutResult {
+    bool possible = false;            //минимальный разрез не больше k рёбер
+    bool alreadyDisconnected = false; //пути нет и без удаления рёбер
+    int connectivity = 0;             //число рёберно-непересекающихся путей, не больше k + 1
+    vector<pair<int, int>> cutEdges;  //рёбра минимального разреза (если possible)
+};
+
+//ребро с весом в результатах, которые состоят из набора рёбер
+struct WeightedEdge {
+    int from;
+    int to;
+    int weight;
+};
+
+//минимальный остовный лес: по дереву на каждую компоненту связности
+struct SpanningForestResult {
+    vector<WeightedEdge> edges;       //рёбра леса в порядке добавления
+    long long totalWeight = 0;        //суммарный вес рёбер
+    int trees = 0;                    //кол-во деревьев (компонент связности)
+};
+
+//общая вершина, в которую ведут дуги и из u, и из v
+struct CommonTargetResult {
+    bool found = false;
+    int vertex = -1;
+};
+
+//максимальный поток между двумя вершинами
+struct MaxFlowResult {
+    long long flow = 0;
+    int phases = 0;                   //фаз алгоритма Диница (поисков блокирующего потока)
+};
+
+#endif  // GRAPH_RESULTS_H
@@ -0,0 +1,127 @@
+﻿#ifndef LANDMARKS_H
+#define LANDMARKS_H
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include "DijkstraEngine.h"
+#include "ThreadPool.h"
+using namespace std;
+
+//ориентиры для поиска ALT (A*, ориентиры, неравенство треугольника)
+//для каждого ориентира L хранятся расстояния d(L, v) и d(v, L); по неравенству треугольника
+//d(v, t) >= d(L, t) - d(L, v) и d(v, t) >= d(v, L) - d(t, L), максимум оценок - потенциал для A*
+//индекс строится для конкретного состояния графа и после изменения графа должен быть построен заново
+class LandmarkIndex {
+private:
+    static constexpr int UNREACHED = INT_MAX;
+
+    int numVertices = 0;
+    vector<int> landmarks;
+    vector<int> fromLandmark;                    //d(L, v), строка на ориентир
+    vector<int> toLandmark;                      //d(v, L), строка на ориентир
+
+public:
+    LandmarkIndex() = default;
+
+    //count ориентиров выбираются как самые далёкие от уже выбранных (первый - самый далёкий от первой
+    //неудалённой вершины); вершины, не достижимые ни из одного ориентира, считаются самыми далёкими
+    //reverseGraph - входящие рёбра graph, по нему считаются расстояния до ориентиров (параллельно)
+    //removed - отметки удалённых (изолированных) вершин: ориентирами они не становятся и в count не входят
+    template <class G, class R>
+    LandmarkIndex(const G& graph, const R& reverseGraph, int count, const vector<char>* removed = nullptr,
+        ThreadPool& pool = ThreadPool::shared())
+        : numVertices(graph.getNumVertices()) {
+        auto isRemoved = [removed](int v) { return removed && (*removed)[v]; };
+        int liveVertices = numVertices;
+        if (removed) {
+            liveVertices -= (int)std::count(removed->begin(), removed->end(), 1);
+        }
+        count = min(count, liveVertices);
+        if (count <= 0) {
+            return;
+        }
+        int seed = 0;
+        while (isRemoved(seed)) {
+            ++seed;
+        }
+        DijkstraEngine engine;
+        vector<int> nearest(numVertices, UNREACHED); //расстояние до ближайшего выбранного ориентира
+        engine.findAllDistances(graph, seed);
+        int candidate = seed;
+        for (int v = 0; v < numVertices; ++v) {
+            if (isRemoved(v)) {
+                continue;
+            }
+            if (!engine.isReached(v)) {
+                candidate = v;
+                break;
+            }
+            if (engine.getDistance(v) > engine.getDistance(candidate)) {
+                candidate = v;
+            }
+        }
+
+        fromLandmark.assign((size_t)count * numVertices, UNREACHED);
+        while ((int)landmarks.size() < count) {
+            int index = (int)landmarks.size();
+            landmarks.push_back(candidate);
+            engine.findAllDistances(graph, candidate);
+            int* row = &fromLandmark[(size_t)index * numVertices];
+            for (int v = 0; v < numVertices; ++v) {
+                row[v] = engine.getDistance(v);
+                nearest[v] = min(nearest[v], row[v]);
+            }
+            //следующий ориентир: максимум расстояния до ближайшего ориентира (недостижимые - в первую очередь)
+            candidate = -1;
+            for (int v = 0; v < numVertices; ++v) {
+                if (!isRemoved(v) && nearest[v] != 0 && (candidate == -1 || nearest[v] > nearest[candidate])) {
+                    candidate = v;
+                }
+            }
+            if (candidate == -1) {
+                break; //все вершины уже ориентиры
+            }
+        }
+        fromLandmark.resize(landmarks.size() * numVertices);
+
+        toLandmark.assign(landmarks.size() * numVertices, UNREACHED);
+        vector<DijkstraEngine> engines(pool.size());
+        pool.parallelFor((int)landmarks.size(), [&](int worker, int index) {
+            engines[worker].findAllDistances(reverseGraph, landmarks[index]);
+            int* row = &toLandmark[(size_t)index * numVertices];
+            for (int v = 0; v < numVertices; ++v) {
+                row[v] = engines[worker].getDistance(v);
+            }
+        });
+    }
+
+    int getNumVertices() const {
+        return numVertices;
+    }
+    const vector<int>& getLandmarks() const {
+        return landmarks;
+    }
+
+    //нижняя оценка d(v, target); INT_MAX, если по расстояниям до ориентиров видно, что target из v недостижима
+    int lowerBound(int v, int target) const {
+        long long bound = 0;
+        for (size_t i = 0; i < landmarks.size(); ++i) {
+            const int* from = &fromLandmark[i * numVertices];
+            const int* to = &toLandmark[i * numVertices];
+            //L достигает v, но не target - значит, и v не достигает target (и наоборот для путей в L)
+            if ((from[v] != UNREACHED && from[target] == UNREACHED) || (to[v] == UNREACHED && to[target] != UNREACHED)) {
+                return INT_MAX;
+            }
+            if (from[v] != UNREACHED) {
+                bound = max(bound, (long long)from[target] - from[v]);
+            }
+            if (to[target] != UNREACHED) {
+                bound = max(bound, (long long)to[v] - to[target]);
+            }
+        }
+        return (int)min(bound, (long long)INT_MAX - 1);
+    }
+};
+
+#endif  // LANDMARKS_H
@@ -0,0 +1,118 @@
+﻿#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+//файл, отображённый в память только для чтения
+//данные доступны, пока объект жив; пустой файл даёт data() == nullptr и size() == 0
+class MappedFile {
+private:
+    const char* fileData = nullptr;
+    size_t fileSize = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    void release() {
+#ifdef _WIN32
+        if (fileData) UnmapViewOfFile(fileData);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (fileData) munmap(const_cast<char*>(fileData), fileSize);
+        if (fd != -1) close(fd);
+        fd = -1;
+#endif
+        fileData = nullptr;
+        fileSize = 0;
+    }
+
+public:
+    explicit MappedFile(const string& filename) {
+#ifdef _WIN32
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw runtime_error("Ошибка открытия файла для чтения!");
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            release();
+            throw runtime_error("Ошибка чтения размера файла!");
+        }
+        fileSize = (size_t)size.QuadPart;
+        if (fileSize == 0) {
+            return;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            release();
+            throw runtime_error("Ошибка отображения файла в память!");
+        }
+        fileData = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!fileData) {
+            release();
+            throw runtime_error("Ошибка отображения файла в память!");
+        }
+#else
+        fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw runtime_error("Ошибка открытия файла для чтения!");
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            release();
+            throw runtime_error("Ошибка чтения размера файла!");
+        }
+        fileSize = (size_t)info.st_size;
+        if (fileSize == 0) {
+            return;
+        }
+        void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            fileSize = 0;
+            release();
+            throw runtime_error("Ошибка отображения файла в память!");
+        }
+        fileData = (const char*)mapped;
+        madvise(mapped, fileSize, MADV_SEQUENTIAL);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        release();
+    }
+
+    const char* data() const {
+        return fileData;
+    }
+    size_t size() const {
+        return fileSize;
+    }
+};
+
+#endif  // MAPPED_FILE_H
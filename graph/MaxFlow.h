@@ -0,0 +1,201 @@
+﻿#ifndef MAX_FLOW_H
+#define MAX_FLOW_H
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <climits>
+#include "PerfCounters.h"
+using namespace std;
+
+//максимальный поток алгоритмом Диница на остаточной сети со списками рёбер
+//рёбра хранятся парами: прямое с чётным номером id и обратное id ^ 1, так что память O(V + E),
+//а не O(V^2), и каждая фаза (BFS слоёв + блокирующий поток) проходит только по существующим рёбрам
+class MaxFlowEngine {
+private:
+    int numVertices;
+    vector<int> arcTo;                           //конец ребра
+    vector<long long> arcCapacity;               //остаточная пропускная способность
+    vector<int> arcFrom;                         //начало ребра (только для построения списков)
+    vector<int> firstArc;                        //CSR: рёбра вершины u - arcsOf[firstArc[u] .. firstArc[u + 1])
+    vector<int> arcsOf;
+    bool built = false;
+    vector<int> level;                           //номер слоя в текущей фазе, -1 - вершина не достигнута
+    vector<int> currentArc;                      //позиция, с которой DFS продолжает перебор рёбер вершины
+    vector<int> queue;
+    vector<int> pathArcs;                        //рёбра текущего пути DFS
+
+    //раскладывает рёбра по начальным вершинам (сортировка подсчётом)
+    void build() {
+        firstArc.assign(numVertices + 1, 0);
+        for (int from : arcFrom) {
+            ++firstArc[from + 1];
+        }
+        for (int u = 0; u < numVertices; ++u) {
+            firstArc[u + 1] += firstArc[u];
+        }
+        arcsOf.resize(arcTo.size());
+        vector<int> fill(firstArc.begin(), firstArc.end() - 1);
+        for (int id = 0; id < (int)arcTo.size(); ++id) {
+            arcsOf[fill[arcFrom[id]]++] = id;
+        }
+        level.resize(numVertices);
+        currentArc.resize(numVertices);
+        built = true;
+    }
+
+    //BFS по рёбрам с положительной остаточной способностью; true, если сток достижим
+    bool buildLevels(int source, int sink) {
+        PERF_COUNT(BfsSweeps, 1);
+        std::fill(level.begin(), level.end(), -1);
+        queue.clear();
+        level[source] = 0;
+        queue.push_back(source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            for (int pos = firstArc[u]; pos < firstArc[u + 1]; ++pos) {
+                int id = arcsOf[pos];
+                int v = arcTo[id];
+                if (arcCapacity[id] > 0 && level[v] == -1) {
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+        return level[sink] != -1;
+    }
+
+    //блокирующий поток в слоистой сети итеративным DFS (без рекурсии, длина пути до V)
+    long long blockingFlow(int source, int sink, long long limit) {
+        for (int u = 0; u < numVertices; ++u) {
+            currentArc[u] = firstArc[u];
+        }
+        long long total = 0;
+        pathArcs.clear();
+        int u = source;
+        while (total < limit) {
+            if (u == sink) {
+                //путь найден: проталкиваем минимум остаточных способностей
+                long long push = limit - total;
+                for (int id : pathArcs) {
+                    push = min(push, arcCapacity[id]);
+                }
+                for (int id : pathArcs) {
+                    arcCapacity[id] -= push;
+                    arcCapacity[id ^ 1] += push;
+                }
+                total += push;
+                PERF_COUNT(AugmentingPaths, 1);
+                //возвращаемся к началу первого насыщенного ребра
+                size_t keep = 0;
+                while (keep < pathArcs.size() && arcCapacity[pathArcs[keep]] > 0) {
+                    ++keep;
+                }
+                pathArcs.resize(keep);
+                u = keep == 0 ? source : arcTo[pathArcs.back()];
+                continue;
+            }
+            bool advanced = false;
+            for (int& pos = currentArc[u]; pos < firstArc[u + 1]; ++pos) {
+                int id = arcsOf[pos];
+                int v = arcTo[id];
+                if (arcCapacity[id] > 0 && level[v] == level[u] + 1) {
+                    pathArcs.push_back(id);
+                    u = v;
+                    advanced = true;
+                    break;
+                }
+            }
+            if (!advanced) {
+                //тупик: вершина больше не нужна в этой фазе
+                level[u] = -1;
+                if (pathArcs.empty()) {
+                    break;
+                }
+                u = arcTo[pathArcs.back() ^ 1];
+                pathArcs.pop_back();
+                ++currentArc[u];
+            }
+        }
+        return total;
+    }
+
+public:
+    explicit MaxFlowEngine(int numVertices) : numVertices(numVertices) {}
+
+    //память под edges рёбер (с парными обратными) без перераспределений при addEdge()
+    void reserve(size_t edges) {
+        arcTo.reserve(edges * 2);
+        arcFrom.reserve(edges * 2);
+        arcCapacity.reserve(edges * 2);
+    }
+
+    //добавляет ребро u -> v и парное обратное с нулевой способностью, возвращает номер прямого
+    int addEdge(int u, int v, long long capacity) {
+        int id = (int)arcTo.size();
+        arcTo.push_back(v);
+        arcFrom.push_back(u);
+        arcCapacity.push_back(max(capacity, 0LL));
+        arcTo.push_back(u);
+        arcFrom.push_back(v);
+        arcCapacity.push_back(0);
+        built = false;
+        return id;
+    }
+
+    //максимальный поток source -> sink; останавливается, как только поток достиг limit
+    //onPhase(phase, flow) вызывается после каждой фазы (для отладочного вывода)
+    long long maxFlow(int source, int sink, long long limit = LLONG_MAX,
+        const function<void(int, long long)>& onPhase = nullptr) {
+        if (source == sink) {
+            return 0;
+        }
+        if (!built) {
+            build();
+        }
+        long long flow = 0;
+        for (int phase = 1; flow < limit && buildLevels(source, sink); ++phase) {
+            flow += blockingFlow(source, sink, limit - flow);
+            if (onPhase) {
+                onPhase(phase, flow);
+            }
+        }
+        return flow;
+    }
+
+    //вершины, достижимые из source по остаточной сети (сторона source минимального разреза)
+    vector<char> sourceSide(int source) {
+        if (!built) {
+            build();
+        }
+        vector<char> reached(numVertices, 0);
+        queue.clear();
+        reached[source] = 1;
+        queue.push_back(source);
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            for (int pos = firstArc[u]; pos < firstArc[u + 1]; ++pos) {
+                int id = arcsOf[pos];
+                if (arcCapacity[id] > 0 && !reached[arcTo[id]]) {
+                    reached[arcTo[id]] = 1;
+                    queue.push_back(arcTo[id]);
+                }
+            }
+        }
+        return reached;
+    }
+
+    int getNumArcs() const {
+        return (int)arcTo.size();
+    }
+    int getArcFrom(int id) const {
+        return arcFrom[id];
+    }
+    int getArcTo(int id) const {
+        return arcTo[id];
+    }
+    long long getResidualCapacity(int id) const {
+        return arcCapacity[id];
+    }
+};
+
+#endif  // MAX_FLOW_H
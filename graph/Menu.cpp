@@ -9,6 +9,63 @@
 #include "Graph.h"
 using namespace std;
 
+//    
+static void printPath(const Graph& graph, const PathResult& path, const string& from, const string& to) {
+    if (!path.found) {
+        cout << " " << to << "   " << from << "." << endl;
+        return;
+    }
+    cout << "   " << from << "  " << to << ": ";
+    for (int vertex : path.vertices) {
+        cout << graph.getVertexName(vertex) << " ";
+    }
+    cout << endl;
+    cout << " : " << path.distance << endl;
+}
+
+//   
+static void printSpanningForest(const Graph& graph, const SpanningForestResult& forest) {
+    if (forest.trees > 1) {
+        cout << " ,     " << forest.trees << " :" << endl;
+    }
+    else {
+        cout << "  :" << endl;
+    }
+    for (const WeightedEdge& edge : forest.edges) {
+        cout << graph.getVertexName(edge.from) << " - " << graph.getVertexName(edge.to) << " (: " << edge.weight << ")" << endl;
+    }
+    cout << "   : " << forest.totalWeight << endl;
+}
+
+//       k 
+static void printEdgeCut(const Graph& graph, const EdgeCutResult& cut, const string& u, const string& v, int k) {
+    if (cut.alreadyDisconnected) {
+        cout << " " << u << "  " << v << "  ." << endl;
+    }
+    else if (cut.possible) {
+        cout << "    " << u << "  " << v << "    "
+            << cut.cutEdges.size() << " ." << endl;
+        cout << "и  : ";
+        for (const auto& edge : cut.cutEdges) {
+            cout << "(" << graph.getVertexName(edge.first) << ", " << graph.getVertexName(edge.second) << ") ";
+        }
+        cout << endl;
+    }
+    else {
+        cout << "    " << u << "  " << v << "   " << k
+            << " ." << endl;
+    }
+}
+
+//    ( ,  )
+static bool checkVertices(const Graph& graph, const string& from, const string& to) {
+    if (graph.findVertex(from) == -1 || graph.findVertex(to) == -1) {
+        cout << "     !" << endl;
+        return false;
+    }
+    return true;
+}
+
 void graphMenu(Graph& graph) {
     int option;
     string from, to, name, filename;
@@ -102,7 +159,15 @@ void graphMenu(Graph& graph) {
             cin >> from;
             cout << "  : ";
             cin >> to;
-            graph.findCommonTarget(from, to);
+            if (checkVertices(graph, from, to)) {
+                CommonTargetResult common = graph.findCommonTarget(from, to);
+                if (common.found) {
+                    cout << " : " << graph.getVertexName(common.vertex) << endl;
+                }
+                else {
+                    cout << "  ,       " << from << "   " << to << endl;
+                }
+            }
             break;
 
         case 9:
@@ -116,14 +181,22 @@ void graphMenu(Graph& graph) {
                 cin.clear();
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
-            graph.canDisconnectWithKEdges(from, to, k, graph.isDirected());
+            if (checkVertices(graph, from, to)) {
+                printEdgeCut(graph, graph.canDisconnectWithKEdges(from, to, k, graph.isDirected()), from, to, k);
+            }
             break;
 
         case 10:
             if (graph.isDirected()) {
                 cout << "  : ";
                 cin >> name;
-                graph.getOutDegree(name);
+                int outDegree = graph.getOutDegree(name);
+                if (outDegree == -1) {
+                    cout << " " << name << "  !" << endl;
+                }
+                else {
+                    cout << "   " << name << " : " << outDegree << endl;
+                }
             }
             else {
                 cout << "     .\n";
@@ -135,6 +208,7 @@ void graphMenu(Graph& graph) {
                 Graph reversedGraph = graph.reverseGraph();
                 cout << "  .     :\n";
                 reversedGraph.printAdjList();
+                reversedGraph.saveToFile("reversed_graph.txt");
             }
             else {
                 cout << "     .\n";
@@ -145,7 +219,12 @@ void graphMenu(Graph& graph) {
             cout << "  : " << graph.findCyclomaticNumber() << endl;
             break;
         case 13:
-            graph.findMinimumSpanningTree();
+            if (graph.isDirected()) {
+                cout << "       ." << endl;
+            }
+            else {
+                printSpanningForest(graph, graph.findMinimumSpanningTree());
+            }
             break;
 
         case 14: 
@@ -153,7 +232,10 @@ void graphMenu(Graph& graph) {
             cin >> from;
             cout << "  : ";
             cin >> to;
-            graph.findShortestPathDijkstra(from, to);
+            if (!checkVertices(graph, from, to)) {
+                break;
+            }
+            printPath(graph, graph.findShortestPathDijkstra(from, to), from, to);
             break;
         case 15:
             cout << "  : ";
@@ -167,7 +249,19 @@ void graphMenu(Graph& graph) {
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
 
-            graph.findPathWithinL(from, to, k);
+            if (checkVertices(graph, from, to)) {
+                PathResult path = graph.findPathWithinL(from, to, k);
+                if (!path.found) {
+                    cout << "      ,  " << k << endl;
+                    break;
+                }
+                cout << "  " << from << "  " << to << "   <= " << k << "\n";
+                cout << "   : " << path.distance << "\n";
+                for (int vertex : path.vertices) {
+                    cout << graph.getVertexName(vertex) << " ";
+                }
+                cout << endl;
+            }
             break;
         case 16:
             cout << " N: ";
@@ -176,15 +270,29 @@ void graphMenu(Graph& graph) {
                 cin.clear();
                 cin.ignore(numeric_limits<streamsize>::max(), '\n');
             }
-            graph.getVerticesWithPathsBelowN(k);
+            {
+                VerticesBelowNResult found = graph.getVerticesWithPathsBelowN(k);
+                if (found.negativeCycle) {
+                    cout << "   .  ." << endl;
+                }
+                else if (!found.vertices.empty()) {
+                    cout << ",   (   " << k << "): ";
+                    for (int vertex : found.vertices) {
+                        cout << graph.getVertexName(vertex) << " ";
+                    }
+                    cout << endl;
+                }
+                else {
+                    cout << "   ,  ." << endl;
+                }
+            }
             break;
         case 17:
             cout << "  : ";
             cin >> from;
             cout << "  : ";
             cin >> to;
-            cout<<graph.fordFulkerson(from, to);
-             
+            cout << " : " << graph.fordFulkerson(from, to).flow << endl;
             break;
         case 18:
             graph.visualizeGraph(graph);
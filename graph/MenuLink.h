@@ -2,7 +2,7 @@
 #define MY_FUNCTIONS_H
 
 //    Graph
-class Graph;
+#include "GraphFwd.h"
 
 //  
 void graphMenu(Graph& graph);
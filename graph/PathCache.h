@@ -0,0 +1,155 @@
+﻿#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include "FloydWarshall.h"
+using namespace std;
+
+//дерево кратчайших путей от одной вершины: расстояния (максимум DistanceT - не достигнута) и предшественники
+template <class DistanceT = int>
+struct BasicShortestPathTree {
+    vector<DistanceT> distance;
+    vector<int> predecessor;
+};
+using ShortestPathTree = BasicShortestPathTree<int>;
+
+//счётчики кэша путей
+struct PathCacheStats {
+    size_t treeHits = 0;
+    size_t treeMisses = 0;
+    size_t matrixHits = 0;
+    size_t matrixMisses = 0;
+    size_t invalidations = 0;                    //сколько раз кэш сброшен из-за изменения графа
+    size_t cachedTrees = 0;
+};
+
+//кэш деревьев кратчайших путей по начальной вершине (LRU ограниченного размера) и матрицы всех пар
+//записи действительны для одной версии графа: запрос с другой версией очищает кэш
+//результаты отдаются как shared_ptr на неизменяемые данные, поэтому вытеснение не мешает читающим
+//методы потокобезопасны; считать дерево при промахе вызывающая сторона может без блокировки
+//DistanceT - тип расстояний в деревьях; матрица всех пар есть только для весов int
+template <class DistanceT = int>
+class BasicShortestPathCache {
+public:
+    using Tree = BasicShortestPathTree<DistanceT>;
+
+private:
+    mutable mutex lock;
+    size_t capacity;
+    uint64_t version = 0;
+    list<int> recent;                            //начальные вершины, от недавно использованных к давним
+    unordered_map<int, pair<shared_ptr<const Tree>, list<int>::iterator>> trees;
+    shared_ptr<const AllPairsShortestPaths> matrix;
+    unordered_set<int> missedSources;            //начальные вершины с одним промахом в текущей версии
+    PathCacheStats stats;
+
+    //под блокировкой: сбрасывает записи другой версии графа
+    void syncVersion(uint64_t graphVersion) {
+        if (version == graphVersion) {
+            return;
+        }
+        if (!trees.empty() || matrix) {
+            ++stats.invalidations;
+        }
+        trees.clear();
+        recent.clear();
+        matrix.reset();
+        missedSources.clear();
+        version = graphVersion;
+    }
+
+public:
+    explicit BasicShortestPathCache(size_t capacity = 64) : capacity(capacity) {}
+
+    //дерево от source или nullptr (промах)
+    shared_ptr<const Tree> findTree(uint64_t graphVersion, int source) {
+        lock_guard<mutex> guard(lock);
+        syncVersion(graphVersion);
+        auto it = trees.find(source);
+        if (it == trees.end()) {
+            ++stats.treeMisses;
+            return nullptr;
+        }
+        ++stats.treeHits;
+        recent.splice(recent.begin(), recent, it->second.second);
+        return it->second.first;
+    }
+
+    //вызывается после промаха: стоит ли считать и сохранять полное дерево от source
+    //да, если кэш включён и от source уже был промах в этой версии графа; иначе запрос
+    //дешевле довести только до цели
+    bool isRepeatedMiss(uint64_t graphVersion, int source) {
+        lock_guard<mutex> guard(lock);
+        syncVersion(graphVersion);
+        if (capacity == 0) {
+            return false;
+        }
+        if (missedSources.erase(source) > 0) {
+            return true;
+        }
+        if (missedSources.size() >= capacity * 4) {
+            missedSources.clear();
+        }
+        missedSources.insert(source);
+        return false;
+    }
+
+    void storeTree(uint64_t graphVersion, int source, shared_ptr<const Tree> tree) {
+        lock_guard<mutex> guard(lock);
+        syncVersion(graphVersion);
+        if (capacity == 0 || trees.count(source)) {
+            return;
+        }
+        if (trees.size() >= capacity) {
+            trees.erase(recent.back());
+            recent.pop_back();
+        }
+        recent.push_front(source);
+        trees.emplace(source, make_pair(move(tree), recent.begin()));
+    }
+
+    //матрица всех пар или nullptr (промах)
+    shared_ptr<const AllPairsShortestPaths> findMatrix(uint64_t graphVersion) {
+        lock_guard<mutex> guard(lock);
+        syncVersion(graphVersion);
+        if (!matrix) {
+            ++stats.matrixMisses;
+            return nullptr;
+        }
+        ++stats.matrixHits;
+        return matrix;
+    }
+
+    void storeMatrix(uint64_t graphVersion, shared_ptr<const AllPairsShortestPaths> paths) {
+        lock_guard<mutex> guard(lock);
+        syncVersion(graphVersion);
+        matrix = move(paths);
+    }
+
+    //новая ёмкость; лишние давние деревья вытесняются сразу
+    void setCapacity(size_t newCapacity) {
+        lock_guard<mutex> guard(lock);
+        capacity = newCapacity;
+        while (trees.size() > capacity) {
+            trees.erase(recent.back());
+            recent.pop_back();
+        }
+    }
+
+    PathCacheStats getStats() const {
+        lock_guard<mutex> guard(lock);
+        PathCacheStats snapshot = stats;
+        snapshot.cachedTrees = trees.size();
+        return snapshot;
+    }
+};
+
+using ShortestPathCache = BasicShortestPathCache<int>;
+
+#endif  // PATH_CACHE_H
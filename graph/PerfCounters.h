@@ -0,0 +1,224 @@
+﻿#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+
+//счётчики работы алгоритмов и время фаз для разбора медленных запросов
+//собираются только при определённом GRAPH_PERF_COUNTERS (например, /D GRAPH_PERF_COUNTERS):
+//без него макросы PERF_COUNT и PERF_PHASE пустые, а snapshot() и writeChromeTrace() возвращают пустые данные
+//у каждого потока свой блок счётчиков, в который пишет только он сам, поэтому счёт не требует синхронизации
+namespace perf {
+
+    enum Counter {
+        SettledVertices,        //вершины с окончательным расстоянием (Дейкстра, A*, двунаправленный поиск)
+        RelaxedEdges,           //просмотренные рёбра при релаксации
+        HeapPushes,             //добавления в кучу
+        StalePops,              //извлечённые из кучи устаревшие записи
+        AugmentingPaths,        //увеличивающие пути в максимальном потоке
+        BfsSweeps,              //обходы в ширину для построения слоёв потока
+        RelaxationPasses,       //проходы Беллмана-Форда
+        ForestRounds,           //раунды алгоритма Борувки
+        ForestEdgeScans,        //рёбра, просмотренные в раундах Борувки
+        COUNTER_COUNT
+    };
+
+    inline const char* counterName(Counter counter) {
+        static const char* const names[COUNTER_COUNT] = {
+            "settledVertices", "relaxedEdges", "heapPushes", "stalePops", "augmentingPaths",
+            "bfsSweeps", "relaxationPasses", "forestRounds", "forestEdgeScans"
+        };
+        return names[counter];
+    }
+
+    //суммарное время фазы (вызова метода Graph) по всем потокам
+    struct PhaseStats {
+        string name;
+        uint64_t calls = 0;
+        double milliseconds = 0;
+    };
+
+    //снимок счётчиков, сложенных по всем потокам
+    struct Snapshot {
+        uint64_t counters[COUNTER_COUNT] = {};
+        vector<PhaseStats> phases;               //по алфавиту
+
+        uint64_t get(Counter counter) const {
+            return counters[counter];
+        }
+    };
+
+#ifdef GRAPH_PERF_COUNTERS
+    constexpr bool ENABLED = true;
+
+    //завершённая фаза для трассировки: начало и длительность в микросекундах от запуска
+    struct TraceEvent {
+        string name;
+        double start;
+        double duration;
+    };
+
+    struct ThreadBlock {
+        atomic<uint64_t> counters[COUNTER_COUNT] = {};
+        mutex lock;                              //фазы и события пишутся редко, под блокировкой
+        map<string, PhaseStats> phases;
+        vector<TraceEvent> events;
+        int threadId = 0;
+    };
+
+    struct Registry {
+        mutex lock;
+        vector<shared_ptr<ThreadBlock>> blocks;  //блоки завершившихся потоков тоже остаются в сумме
+        chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+        atomic<bool> recording{ false };
+
+        static Registry& instance() {
+            static Registry registry;
+            return registry;
+        }
+    };
+
+    inline ThreadBlock& local() {
+        thread_local shared_ptr<ThreadBlock> block = [] {
+            auto created = make_shared<ThreadBlock>();
+            Registry& registry = Registry::instance();
+            lock_guard<mutex> guard(registry.lock);
+            created->threadId = (int)registry.blocks.size() + 1;
+            registry.blocks.push_back(created);
+            return created;
+        }();
+        return *block;
+    }
+
+    //счётчик меняет только его поток: обычные load/store без атомарного сложения
+    inline void add(Counter counter, uint64_t amount) {
+        atomic<uint64_t>& value = local().counters[counter];
+        value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+    //время от создания до разрушения объекта добавляется к фазе name (и в трассировку, если она включена)
+    class ScopedPhase {
+    private:
+        const char* name;
+        chrono::steady_clock::time_point start;
+
+    public:
+        explicit ScopedPhase(const char* name) : name(name), start(chrono::steady_clock::now()) {}
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        ~ScopedPhase() {
+            auto end = chrono::steady_clock::now();
+            Registry& registry = Registry::instance();
+            ThreadBlock& block = local();
+            lock_guard<mutex> guard(block.lock);
+            PhaseStats& phase = block.phases[name];
+            ++phase.calls;
+            phase.milliseconds += chrono::duration<double, milli>(end - start).count();
+            if (registry.recording.load(memory_order_relaxed)) {
+                block.events.push_back({ name, chrono::duration<double, micro>(start - registry.origin).count(),
+                    chrono::duration<double, micro>(end - start).count() });
+            }
+        }
+    };
+
+    inline Snapshot snapshot() {
+        Snapshot result;
+        map<string, PhaseStats> phases;
+        Registry& registry = Registry::instance();
+        lock_guard<mutex> guard(registry.lock);
+        for (const auto& block : registry.blocks) {
+            for (int c = 0; c < COUNTER_COUNT; ++c) {
+                result.counters[c] += block->counters[c].load(memory_order_relaxed);
+            }
+            lock_guard<mutex> blockGuard(block->lock);
+            for (const auto& entry : block->phases) {
+                PhaseStats& total = phases[entry.first];
+                total.name = entry.first;
+                total.calls += entry.second.calls;
+                total.milliseconds += entry.second.milliseconds;
+            }
+        }
+        for (auto& entry : phases) {
+            result.phases.push_back(move(entry.second));
+        }
+        return result;
+    }
+
+    //обнуляет счётчики, фазы и события; вызывать, когда алгоритмы не выполняются
+    inline void reset() {
+        Registry& registry = Registry::instance();
+        lock_guard<mutex> guard(registry.lock);
+        for (const auto& block : registry.blocks) {
+            for (auto& counter : block->counters) {
+                counter.store(0, memory_order_relaxed);
+            }
+            lock_guard<mutex> blockGuard(block->lock);
+            block->phases.clear();
+            block->events.clear();
+        }
+    }
+
+    //включает запись событий фаз для writeChromeTrace
+    inline void setTraceRecording(bool enabled) {
+        Registry::instance().recording = enabled;
+    }
+
+    //события фаз в формате Chrome trace event (chrome://tracing, Perfetto): по событию "X" на вызов
+    inline void writeChromeTrace(ostream& out) {
+        Registry& registry = Registry::instance();
+        lock_guard<mutex> guard(registry.lock);
+        out << "{\"traceEvents\": [";
+        bool first = true;
+        for (const auto& block : registry.blocks) {
+            lock_guard<mutex> blockGuard(block->lock);
+            for (const TraceEvent& event : block->events) {
+                out << (first ? "\n" : ",\n") << "  {\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                    << block->threadId << ", \"ts\": " << event.start << ", \"dur\": " << event.duration << "}";
+                first = false;
+            }
+        }
+        out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    }
+
+#define PERF_CONCAT_INNER(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_INNER(a, b)
+#define PERF_COUNT(counter, amount) perf::add(perf::counter, (amount))
+#define PERF_PHASE(name) perf::ScopedPhase PERF_CONCAT(perfPhase, __LINE__)(name)
+
+#else
+    constexpr bool ENABLED = false;
+
+    inline Snapshot snapshot() {
+        return Snapshot();
+    }
+    inline void reset() {}
+    inline void setTraceRecording(bool) {}
+    inline void writeChromeTrace(ostream& out) {
+        out << "{\"traceEvents\": []}\n";
+    }
+
+#define PERF_COUNT(counter, amount) ((void)0)
+#define PERF_PHASE(name) ((void)0)
+
+#endif
+
+    inline void writeChromeTrace(const string& filename) {
+        ofstream out(filename);
+        if (!out) {
+            throw runtime_error("Ошибка открытия файла для записи!");
+        }
+        writeChromeTrace(out);
+    }
+}
+
+#endif  // PERF_COUNTERS_H
@@ -0,0 +1,170 @@
+﻿#ifndef SPANNING_FOREST_H
+#define SPANNING_FOREST_H
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include "GraphResults.h"
+#include "DisjointSets.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h"
+using namespace std;
+
+namespace algo {
+
+    //минимальный остовный лес неориентированного графа параллельным алгоритмом Борувки
+    //в каждом раунде каждая компонента выбирает самое лёгкое выходящее из неё ребро (параллельно, атомарным минимумом),
+    //выбранные рёбра объединяют компоненты, а рёбра внутри компонент отбрасываются; раундов не больше log V
+    //равные веса различаются номером ребра, поэтому выбранные рёбра никогда не образуют цикл
+    template <class G>
+    SpanningForestResult findMinimumSpanningForest(const G& graph, ThreadPool& pool = ThreadPool::shared()) {
+        SpanningForestResult result;
+        int numVertices = graph.getNumVertices();
+        result.trees = numVertices;
+        const int CHUNK = 4096;
+        int vertexChunks = (numVertices + CHUNK - 1) / CHUNK;
+
+        //рёбра (u < v) из списков смежности: подсчёт по кускам вершин, затем заполнение на свои позиции
+        vector<size_t> chunkStart(vertexChunks + 1, 0);
+        pool.parallelFor(vertexChunks, [&](int, int chunk) {
+            size_t count = 0;
+            int last = min(numVertices, (chunk + 1) * CHUNK);
+            for (int u = chunk * CHUNK; u < last; ++u) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    count += u < edge.to;
+                }
+            }
+            chunkStart[chunk + 1] = count;
+        });
+        for (int chunk = 0; chunk < vertexChunks; ++chunk) {
+            chunkStart[chunk + 1] += chunkStart[chunk];
+        }
+        size_t numEdges = chunkStart[vertexChunks];
+        if (numEdges > UINT32_MAX) {
+            throw runtime_error("Слишком много рёбер для построения остовного леса!");
+        }
+        vector<int> from(numEdges), to(numEdges), weight(numEdges);
+        pool.parallelFor(vertexChunks, [&](int, int chunk) {
+            size_t pos = chunkStart[chunk];
+            int last = min(numVertices, (chunk + 1) * CHUNK);
+            for (int u = chunk * CHUNK; u < last; ++u) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    if (u < edge.to) {
+                        from[pos] = u;
+                        to[pos] = edge.to;
+                        weight[pos] = edge.weight;
+                        ++pos;
+                    }
+                }
+            }
+        });
+
+        //ключ ребра: вес со сдвигом знака в старших 32 битах, номер ребра в младших
+        auto key = [&](uint32_t id) {
+            return ((uint64_t)((uint32_t)weight[id] ^ 0x80000000u) << 32) | id;
+        };
+        const uint64_t NONE = UINT64_MAX;
+        unique_ptr<atomic<uint64_t>[]> best(new atomic<uint64_t>[numVertices]);
+        auto offerMin = [](atomic<uint64_t>& slot, uint64_t value) {
+            uint64_t current = slot.load(memory_order_relaxed);
+            while (value < current && !slot.compare_exchange_weak(current, value, memory_order_relaxed)) {}
+        };
+
+        DisjointSets sets;
+        sets.reset(numVertices);
+        vector<int> root(numVertices);           //корень компоненты каждой вершины на начало раунда
+        for (int v = 0; v < numVertices; ++v) {
+            root[v] = v;
+        }
+        //корни компонент; findRoot не сжимает пути, поэтому параллельное чтение безопасно
+        auto refreshRoots = [&]() {
+            pool.parallelFor(vertexChunks, [&](int, int chunk) {
+                int last = min(numVertices, (chunk + 1) * CHUNK);
+                for (int v = chunk * CHUNK; v < last; ++v) {
+                    root[v] = sets.findRoot(v);
+                }
+            });
+        };
+        vector<uint32_t> live(numEdges), next;   //рёбра между разными компонентами
+        for (size_t i = 0; i < numEdges; ++i) {
+            live[i] = (uint32_t)i;
+        }
+
+        while (!live.empty()) {
+            PERF_COUNT(ForestRounds, 1);
+            PERF_COUNT(ForestEdgeScans, live.size());
+            pool.parallelFor(vertexChunks, [&](int, int chunk) {
+                int last = min(numVertices, (chunk + 1) * CHUNK);
+                for (int v = chunk * CHUNK; v < last; ++v) {
+                    best[v].store(NONE, memory_order_relaxed);
+                }
+            });
+
+            int edgeChunks = (int)((live.size() + CHUNK - 1) / CHUNK);
+            pool.parallelFor(edgeChunks, [&](int, int chunk) {
+                size_t last = min(live.size(), (size_t)(chunk + 1) * CHUNK);
+                for (size_t i = (size_t)chunk * CHUNK; i < last; ++i) {
+                    uint32_t id = live[i];
+                    int a = root[from[id]];
+                    int b = root[to[id]];
+                    if (a != b) {
+                        uint64_t edgeKey = key(id);
+                        offerMin(best[a], edgeKey);
+                        offerMin(best[b], edgeKey);
+                    }
+                }
+            });
+
+            //объединение по выбранным рёбрам; одно ребро может быть выбрано обеими компонентами
+            bool merged = false;
+            for (int v = 0; v < numVertices; ++v) {
+                uint64_t chosen = best[v].load(memory_order_relaxed);
+                if (root[v] != v || chosen == NONE) continue;
+                uint32_t id = (uint32_t)chosen;
+                if (sets.unite(from[id], to[id])) {
+                    result.edges.push_back({ from[id], to[id], weight[id] });
+                    result.totalWeight += weight[id];
+                    merged = true;
+                }
+            }
+            if (!merged) {
+                break;
+            }
+            refreshRoots();
+
+            //оставляем только рёбра между разными компонентами: подсчёт по кускам, затем запись на свои позиции
+            vector<size_t> keptStart(edgeChunks + 1, 0);
+            auto crosses = [&](uint32_t id) {
+                return root[from[id]] != root[to[id]];
+            };
+            pool.parallelFor(edgeChunks, [&](int, int chunk) {
+                size_t last = min(live.size(), (size_t)(chunk + 1) * CHUNK);
+                size_t count = 0;
+                for (size_t i = (size_t)chunk * CHUNK; i < last; ++i) {
+                    count += crosses(live[i]);
+                }
+                keptStart[chunk + 1] = count;
+            });
+            for (int chunk = 0; chunk < edgeChunks; ++chunk) {
+                keptStart[chunk + 1] += keptStart[chunk];
+            }
+            next.resize(keptStart[edgeChunks]);
+            pool.parallelFor(edgeChunks, [&](int, int chunk) {
+                size_t last = min(live.size(), (size_t)(chunk + 1) * CHUNK);
+                size_t pos = keptStart[chunk];
+                for (size_t i = (size_t)chunk * CHUNK; i < last; ++i) {
+                    if (crosses(live[i])) {
+                        next[pos++] = live[i];
+                    }
+                }
+            });
+            live.swap(next);
+        }
+
+        result.trees = numVertices - (int)result.edges.size();
+        return result;
+    }
+}
+
+#endif  // SPANNING_FOREST_H
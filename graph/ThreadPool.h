@@ -0,0 +1,137 @@
+﻿#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+using namespace std;
+
+//пул потоков для параллельных циклов: потоки создаются один раз и ждут следующую задачу
+//parallelFor(count, body) вызывает body(worker, index) для каждого index из [0, count);
+//worker - номер исполнителя в [0, size()), по нему алгоритмы выбирают свой рабочий буфер
+//вызывающий поток тоже выполняет итерации; вложенные вызовы parallelFor из body не допускаются
+class ThreadPool {
+private:
+    vector<thread> workers;
+    mutex jobMutex;                              //одна задача в пуле за раз
+    mutex stateMutex;
+    condition_variable wake;
+    condition_variable finished;
+    const function<void(int, int)>* job = nullptr;
+    int jobCount = 0;
+    atomic<int> nextIndex{ 0 };
+    unsigned jobId = 0;                          //номер задачи, по нему потоки узнают о новой работе
+    int busyWorkers = 0;
+    bool stopping = false;
+    exception_ptr error;
+
+    //выполняет итерации текущей задачи, пока они не закончатся
+    void runIterations(int worker) {
+        for (int index = nextIndex++; index < jobCount; index = nextIndex++) {
+            try {
+                (*job)(worker, index);
+            }
+            catch (...) {
+                lock_guard<mutex> lock(stateMutex);
+                if (!error) {
+                    error = current_exception();
+                }
+                nextIndex = jobCount; //остальные итерации не запускаем
+            }
+        }
+    }
+
+    void workerLoop(int worker) {
+        unsigned seenJob = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(stateMutex);
+                wake.wait(lock, [&] { return stopping || jobId != seenJob; });
+                if (stopping) {
+                    return;
+                }
+                seenJob = jobId;
+            }
+            runIterations(worker);
+            {
+                lock_guard<mutex> lock(stateMutex);
+                if (--busyWorkers == 0) {
+                    finished.notify_one();
+                }
+            }
+        }
+    }
+
+public:
+    //threads - общее число исполнителей вместе с вызывающим потоком
+    explicit ThreadPool(int threads = (int)thread::hardware_concurrency()) {
+        if (threads < 1) {
+            threads = 1;
+        }
+        for (int i = 1; i < threads; ++i) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    //кол-во исполнителей (рабочие потоки + вызывающий)
+    int size() const {
+        return (int)workers.size() + 1;
+    }
+
+    void parallelFor(int count, const function<void(int worker, int index)>& body) {
+        if (count <= 0) {
+            return;
+        }
+        lock_guard<mutex> jobLock(jobMutex);
+        if (workers.empty() || count == 1) {
+            for (int index = 0; index < count; ++index) {
+                body(0, index);
+            }
+            return;
+        }
+        {
+            lock_guard<mutex> lock(stateMutex);
+            job = &body;
+            jobCount = count;
+            nextIndex = 0;
+            error = nullptr;
+            busyWorkers = (int)workers.size();
+            ++jobId;
+        }
+        wake.notify_all();
+        runIterations(0);
+        {
+            unique_lock<mutex> lock(stateMutex);
+            finished.wait(lock, [&] { return busyWorkers == 0; });
+            job = nullptr;
+        }
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+
+    //общий пул на всё приложение
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+#endif  // THREAD_POOL_H
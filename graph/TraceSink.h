@@ -0,0 +1,28 @@
+﻿#ifndef TRACE_SINK_H
+#define TRACE_SINK_H
+#include <iostream>
+#include <string_view>
+using namespace std;
+
+//приёмник промежуточных сообщений алгоритмов (например, остаточная сеть после фазы потока)
+//алгоритмы проверяют указатель на приёмник и без него не формируют сообщения вовсе
+class TraceSink {
+public:
+    virtual ~TraceSink() = default;
+    virtual void trace(string_view message) = 0;
+};
+
+//приёмник, печатающий сообщения построчно в поток (для меню - в cout)
+class StreamTraceSink : public TraceSink {
+private:
+    ostream& out;
+
+public:
+    explicit StreamTraceSink(ostream& out = cout) : out(out) {}
+
+    void trace(string_view message) override {
+        out << message << '\n';
+    }
+};
+
+#endif  // TRACE_SINK_H
@@ -0,0 +1,92 @@
+﻿#ifndef TRANSPOSE_H
+#define TRANSPOSE_H
+#include <vector>
+#include <algorithm>
+#include "ThreadPool.h"
+using namespace std;
+
+//транспонирование списков смежности сортировкой подсчётом по концам рёбер за O(V + E), без имён вершин
+//в списке вершины v результата лежат входящие рёбра v исходного графа по возрастанию их начал
+//(при равных началах - в порядке списка смежности), поэтому результат не зависит от числа потоков
+//начальные вершины делятся на отрезки с примерно равным числом рёбер, не больше одного на исполнителя пула:
+//подсчёт и раскладка идут параллельно, у каждого отрезка свои счётчики на V вершин, поэтому отрезков
+//не больше E / V (счётчики занимают O(V + E)) и в каждом не меньше MIN_CHUNK_ARCS рёбер -
+//небольшой граф обходится одним проходом без пула
+//от графа требуется: getNumVertices(), neighbors(u)
+class TransposeBuilder {
+public:
+    static constexpr size_t MIN_CHUNK_ARCS = 65536;
+
+private:
+    vector<int> bounds;                          //отрезок c - начальные вершины [bounds[c], bounds[c + 1])
+    vector<vector<int>> position;                //место следующего ребра отрезка c в списке вершины v
+    vector<int> inDegree;
+    ThreadPool& pool;
+
+public:
+    template <class G>
+    explicit TransposeBuilder(const G& graph, ThreadPool& pool = ThreadPool::shared()) : pool(pool) {
+        int numVertices = graph.getNumVertices();
+        size_t numArcs = 0;
+        for (int u = 0; u < numVertices; ++u) {
+            numArcs += graph.neighbors(u).size();
+        }
+
+        size_t chunkLimit = min(numArcs / MIN_CHUNK_ARCS, numArcs / max(numVertices, 1));
+        int chunks = (int)max<size_t>(1, min({ (size_t)pool.size(), (size_t)numVertices, chunkLimit }));
+        bounds.assign(1, 0);
+        size_t arcs = 0;
+        for (int u = 0; u < numVertices && (int)bounds.size() < chunks; ++u) {
+            arcs += graph.neighbors(u).size();
+            if (arcs * chunks >= numArcs * bounds.size()) {
+                bounds.push_back(u + 1);
+            }
+        }
+        bounds.push_back(numVertices);
+        chunks = (int)bounds.size() - 1;
+
+        position.assign(chunks, vector<int>(numVertices, 0));
+        pool.parallelFor(chunks, [&](int, int chunk) {
+            vector<int>& count = position[chunk];
+            for (int u = bounds[chunk]; u < bounds[chunk + 1]; ++u) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    ++count[edge.to];
+                }
+            }
+        });
+
+        //отрезки идут по возрастанию начал, поэтому место отрезка в списке v - сумма счётчиков предыдущих
+        inDegree.assign(numVertices, 0);
+        for (int v = 0; v < numVertices; ++v) {
+            int pos = 0;
+            for (int chunk = 0; chunk < chunks; ++chunk) {
+                int count = position[chunk][v];
+                position[chunk][v] = pos;
+                pos += count;
+            }
+            inDegree[v] = pos;
+        }
+    }
+
+    //полустепени захода исходного графа - длины списков результата
+    const vector<int>& getInDegrees() const {
+        return inDegree;
+    }
+
+    //раскладывает рёбра (один раз): emit(v, pos, u, weight) для каждого ребра u -> v, pos - место в списке v;
+    //вызывается параллельно из разных отрезков, места не пересекаются, выделять память в emit нельзя
+    template <class G, class Emit>
+    void fill(const G& graph, Emit emit) {
+        int chunks = (int)bounds.size() - 1;
+        pool.parallelFor(chunks, [&](int, int chunk) {
+            vector<int>& next = position[chunk];
+            for (int u = bounds[chunk]; u < bounds[chunk + 1]; ++u) {
+                for (const auto& edge : graph.neighbors(u)) {
+                    emit((int)edge.to, next[edge.to]++, u, edge.weight);
+                }
+            }
+        });
+    }
+};
+
+#endif  // TRANSPOSE_H
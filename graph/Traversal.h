@@ -0,0 +1,117 @@
+﻿#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+//множество посещённых вершин: по одному биту на вершину в 64-битных словах
+//очистка - заполнение слов нулями, в 64 раза меньше памяти, чем байтовый массив
+class VisitedBitset {
+private:
+    vector<uint64_t> words;
+
+public:
+    //готовит множество на numVertices вершин и очищает его
+    void reset(int numVertices) {
+        size_t count = ((size_t)numVertices + 63) / 64;
+        if (words.size() < count) {
+            words.resize(count);
+        }
+        fill(words.begin(), words.begin() + count, 0);
+    }
+
+    bool test(int v) const {
+        return (words[(size_t)v >> 6] >> (v & 63)) & 1;
+    }
+
+    //отмечает вершину; false, если она уже была отмечена
+    bool insert(int v) {
+        uint64_t& word = words[(size_t)v >> 6];
+        uint64_t bit = (uint64_t)1 << (v & 63);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        return true;
+    }
+};
+
+//обходы графа без рекурсии: явный стек для обхода в глубину, очередь для обхода в ширину
+//буферы живут между вызовами, поэтому повторные обходы не выделяют память
+//один объект - один поток; local() даёт отдельный объект для каждого потока
+class TraversalEngine {
+private:
+    VisitedBitset visited;
+    vector<int> frontier;                        //стек или очередь вершин, ёмкость сохраняется
+
+public:
+    static TraversalEngine& local() {
+        static thread_local TraversalEngine engine;
+        return engine;
+    }
+
+    //есть ли путь из u в v; обход в ширину прекращается, как только v найдена
+    template <class G>
+    bool hasPath(const G& graph, int u, int v) {
+        if (u == v) return true;
+        visited.reset(graph.getNumVertices());
+        visited.insert(u);
+        frontier.clear();
+        frontier.push_back(u);
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            for (const auto& edge : graph.neighbors(frontier[head])) {
+                if (edge.to == v) return true;
+                if (visited.insert(edge.to)) {
+                    frontier.push_back(edge.to);
+                }
+            }
+        }
+        return false;
+    }
+
+    //обход в глубину от start по ещё не посещённым вершинам; onVisit(vertex) вызывается для каждой новой вершины
+    //между вызовами посещённые вершины не сбрасываются (для этого есть begin)
+    template <class G, class OnVisit>
+    void visitFrom(const G& graph, int start, OnVisit onVisit) {
+        if (!visited.insert(start)) return;
+        frontier.clear();
+        frontier.push_back(start);
+        while (!frontier.empty()) {
+            int u = frontier.back();
+            frontier.pop_back();
+            onVisit(u);
+            for (const auto& edge : graph.neighbors(u)) {
+                if (visited.insert(edge.to)) {
+                    frontier.push_back(edge.to);
+                }
+            }
+        }
+    }
+
+    //очищает посещённые вершины перед серией вызовов visitFrom
+    void begin(int numVertices) {
+        visited.reset(numVertices);
+    }
+
+    bool isVisited(int v) const {
+        return visited.test(v);
+    }
+
+    //кол-во компонент: число вершин, с которых начинается новый обход (по порядку индексов)
+    template <class G>
+    int countComponents(const G& graph) {
+        int numVertices = graph.getNumVertices();
+        begin(numVertices);
+        int componentCount = 0;
+        for (int i = 0; i < numVertices; ++i) {
+            if (!visited.test(i)) {
+                ++componentCount;
+                visitFrom(graph, i, [](int) {});
+            }
+        }
+        return componentCount;
+    }
+};
+
+#endif  // TRAVERSAL_H
@@ -0,0 +1,298 @@
+﻿#ifndef VERTEX_NAMES_H
+#define VERTEX_NAMES_H
+#include <vector>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <memory_resource>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+//FNV-1a, не зависит от реализации стандартной библиотеки (таблицы сохраняются в бинарный файл)
+inline uint64_t hashVertexName(string_view name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+//таблица имён вершин с плотными индексами 0..size()-1
+//строки хранятся в арене из крупных блоков (блоки берутся у memory_resource графа), индекс -> имя это
+//vector<string_view>, имя -> индекс это открытая адресация с линейным пробированием по индексам имён
+class VertexNames {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024; //размер блока арены
+
+    //возвращает блок тому ресурсу, у которого он взят
+    struct BlockDeleter {
+        pmr::memory_resource* resource;
+        size_t size;
+        void operator()(char* block) const {
+            resource->deallocate(block, size, 1);
+        }
+    };
+    using Block = unique_ptr<char[], BlockDeleter>;
+
+    pmr::memory_resource* resource = pmr::get_default_resource();
+    vector<Block> blocks;                        //блоки арены, адреса строк в них не меняются
+    char* blockPos = nullptr;                    //свободное место в текущем блоке
+    size_t blockLeft = 0;
+    vector<string_view> names;                   //имя вершины по индексу
+    vector<int> slots;                           //хэш-таблица индексов, -1 - пустая ячейка, размер - степень двойки (или 0)
+    vector<char> unlinked;                       //имена, убранные из хэш-таблицы (может быть короче names)
+
+    //забирает блоки и таблицы у other с равным ресурсом; блоки дальше освобождаются через свой ресурс
+    void takeStorage(VertexNames& other) {
+        blocks = move(other.blocks);
+        for (Block& block : blocks) {
+            block.get_deleter().resource = resource;
+        }
+        blockPos = other.blockPos;
+        blockLeft = other.blockLeft;
+        names = move(other.names);
+        slots = move(other.slots);
+        unlinked = move(other.unlinked);
+    }
+
+    char* allocateBlock(size_t size) {
+        blocks.push_back(Block((char*)resource->allocate(size, 1), BlockDeleter{ resource, size }));
+        return blocks.back().get();
+    }
+
+    //копирует строку в арену и возвращает представление на копию
+    string_view store(string_view name) {
+        if (name.size() > blockLeft) {
+            size_t size = max(BLOCK_SIZE, name.size());
+            blockPos = allocateBlock(size);
+            blockLeft = size;
+        }
+        memcpy(blockPos, name.data(), name.size());
+        string_view stored(blockPos, name.size());
+        blockPos += name.size();
+        blockLeft -= name.size();
+        return stored;
+    }
+
+    //ячейка таблицы, где лежит имя или куда его нужно вставить
+    size_t findSlot(string_view name) const {
+        size_t mask = slots.size() - 1;
+        size_t slot = hashVertexName(name) & mask;
+        while (slots[slot] != -1 && names[slots[slot]] != name) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    //перестраивает хэш-таблицу под заданную ёмкость
+    void rehash(size_t capacity) {
+        size_t size = 16;
+        while (size < capacity * 2) {
+            size *= 2;
+        }
+        slots.assign(size, -1);
+        for (int i = 0; i < (int)names.size(); ++i) {
+            if (i >= (int)unlinked.size() || !unlinked[i]) {
+                slots[findSlot(names[i])] = i;
+            }
+        }
+    }
+
+public:
+    VertexNames() = default;
+
+    explicit VertexNames(pmr::memory_resource* resource) : resource(resource) {}
+
+    //копия берёт память у ресурса по умолчанию (как копии pmr-контейнеров)
+    VertexNames(const VertexNames& copy) : VertexNames(copy, pmr::get_default_resource()) {}
+
+    VertexNames(const VertexNames& copy, pmr::memory_resource* resource)
+        : resource(resource), names(copy.names), slots(copy.slots), unlinked(copy.unlinked) {
+        //все имена копируются одним блоком, индексы в хэш-таблице остаются прежними
+        size_t total = 0;
+        for (string_view name : copy.names) {
+            total += name.size();
+        }
+        if (total > 0) {
+            char* pos = allocateBlock(total);
+            for (string_view& name : names) {
+                memcpy(pos, name.data(), name.size());
+                name = string_view(pos, name.size());
+                pos += name.size();
+            }
+        }
+    }
+
+    //перемещение забирает блоки арены вместе с их ресурсом, исходная таблица остаётся пустой
+    VertexNames(VertexNames&& other) noexcept
+        : resource(other.resource), blocks(move(other.blocks)), blockPos(other.blockPos), blockLeft(other.blockLeft),
+        names(move(other.names)), slots(move(other.slots)), unlinked(move(other.unlinked)) {
+        other.clear();
+    }
+    //присваивание оставляет таблице её ресурс (как у pmr-контейнеров): блоки забираются только у таблицы
+    //с равным ресурсом, иначе имена копируются в блоки своего ресурса
+    VertexNames& operator=(VertexNames&& other) {
+        if (this != &other) {
+            if (*resource == *other.resource) {
+                takeStorage(other);
+            }
+            else {
+                VertexNames tmp(other, resource);
+                takeStorage(tmp);
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    VertexNames& operator=(const VertexNames& copy) {
+        if (this != &copy) {
+            VertexNames tmp(copy, resource); //ресурс остаётся прежним
+            *this = move(tmp);
+        }
+        return *this;
+    }
+
+    int size() const {
+        return (int)names.size();
+    }
+
+    pmr::memory_resource* getMemoryResource() const {
+        return resource;
+    }
+
+    //индекс имени или -1, если его нет
+    int find(string_view name) const {
+        if (slots.empty()) {
+            return -1;
+        }
+        return slots[findSlot(name)];
+    }
+
+    //добавляет новое имя и возвращает его индекс, если имя уже есть - возвращает существующий
+    int add(string_view name) {
+        if (slots.empty()) {
+            rehash(1);
+        }
+        size_t slot = findSlot(name);
+        if (slots[slot] != -1) {
+            return slots[slot];
+        }
+        int index = (int)names.size();
+        names.push_back(store(name));
+        if (names.size() * 2 > slots.size()) {
+            rehash(names.size());
+        }
+        else {
+            slots[slot] = index;
+        }
+        return index;
+    }
+
+    string_view operator[](int index) const {
+        return names[index];
+    }
+
+    //хэш-таблица индексов, совместимая с NameTableView
+    const vector<int>& getSlots() const {
+        return slots;
+    }
+
+    //убирает имя из хэш-таблицы (find его больше не находит), индекс и строка остаются до compact()
+    //ячейка освобождается сдвигом следующих записей назад, поэтому цепочки пробирования не рвутся
+    void unlink(int index) {
+        size_t mask = slots.size() - 1;
+        size_t hole = findSlot(names[index]);
+        for (size_t next = (hole + 1) & mask; slots[next] != -1; next = (next + 1) & mask) {
+            size_t home = hashVertexName(names[slots[next]]) & mask;
+            //запись можно перенести в дыру, если дыра лежит между её домашней ячейкой и текущей
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = slots[next];
+                hole = next;
+            }
+        }
+        slots[hole] = -1;
+        unlinked.resize(names.size(), 0);
+        unlinked[index] = 1;
+    }
+
+    //перенумеровывает имена: имя i получает индекс remap[i], при remap[i] == -1 удаляется
+    //новые индексы должны сохранять порядок; байты удалённых строк остаются в арене до clear() или копирования
+    void compact(const vector<int>& remap) {
+        int kept = 0;
+        for (int i = 0; i < (int)names.size(); ++i) {
+            if (remap[i] != -1) {
+                names[kept++] = names[i];
+            }
+        }
+        names.resize(kept);
+        unlinked.clear();
+        rehash(names.size());
+    }
+
+    void reserve(size_t count) {
+        names.reserve(count);
+        if (count * 2 > slots.size()) {
+            rehash(count);
+        }
+    }
+
+    void clear() {
+        blocks.clear();
+        blockPos = nullptr;
+        blockLeft = 0;
+        names.clear();
+        slots.clear();
+        unlinked.clear();
+    }
+};
+
+//таблица имён только для чтения поверх непрерывных массивов: смещения строк, байты строк и хэш-таблица
+//в том же формате, что у VertexNames; используется снимком CsrGraph и бинарным файлом графа
+class NameTableView {
+private:
+    const uint64_t* offsets = nullptr;           //начало имени i - offsets[i], конец - offsets[i + 1]
+    const char* data = nullptr;                  //байты всех имён подряд
+    const int* slots = nullptr;                  //хэш-таблица индексов, -1 - пустая ячейка
+    size_t slotCount = 0;                        //размер хэш-таблицы (степень двойки или 0)
+    int count = 0;
+
+public:
+    NameTableView() = default;
+    NameTableView(const uint64_t* offsets, const char* data, const int* slots, size_t slotCount, int count)
+        : offsets(offsets), data(data), slots(slots), slotCount(slotCount), count(count) {}
+
+    int size() const {
+        return count;
+    }
+
+    string_view operator[](int index) const {
+        return string_view(data + offsets[index], (size_t)(offsets[index + 1] - offsets[index]));
+    }
+
+    const uint64_t* getOffsets() const { return offsets; }
+    const char* getData() const { return data; }
+    const int* getSlots() const { return slots; }
+    size_t getSlotCount() const { return slotCount; }
+
+    //индекс имени или -1, если его нет
+    int find(string_view name) const {
+        if (slotCount == 0) {
+            return -1;
+        }
+        size_t mask = slotCount - 1;
+        size_t slot = hashVertexName(name) & mask;
+        while (slots[slot] != -1) {
+            if ((*this)[slots[slot]] == name) {
+                return slots[slot];
+            }
+            slot = (slot + 1) & mask;
+        }
+        return -1;
+    }
+};
+
+#endif  // VERTEX_NAMES_H
@@ -2,13 +2,68 @@
 #include <string>
 #include "MenuLink.h"
 #include "Graph.h"
+#include "BatchRunner.h"
+#include "Benchmark.h"
+#include "AllocCheck.h"
 #include <SFML/Graphics.hpp>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
     setlocale(0, "");
 
+    //пакетный режим: graph --batch queries.txt [results.txt]
+    if (argc >= 2 && string(argv[1]) == "--batch") {
+        if (argc < 3 || argc > 4) {
+            cout << "Использование: graph --batch <файл запросов> [файл ответов]\n";
+            return 1;
+        }
+        string queriesFile = argv[2];
+        string outputFile = argc == 4 ? string(argv[3]) : queriesFile + ".out";
+        try {
+            BatchRunner runner;
+            runner.runFile(queriesFile, outputFile);
+        }
+        catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    //замеры производительности: graph --bench [results.json] [макс. рёбер]
+    //со сборкой GRAPH_PERF_COUNTERS рядом пишется трассировка фаз results.json.trace.json
+    if (argc >= 2 && string(argv[1]) == "--bench") {
+        string outputFile = argc >= 3 ? string(argv[2]) : "benchmark.json";
+        size_t maxEdges = argc >= 4 ? stoull(argv[3]) : 10000000;
+        try {
+            GraphBenchmark benchmark(maxEdges);
+            perf::setTraceRecording(perf::ENABLED);
+            benchmark.run();
+            benchmark.writeJson(outputFile);
+            if (perf::ENABLED) {
+                perf::writeChromeTrace(outputFile + ".trace.json");
+            }
+        }
+        catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    //проверка числа выделений памяти при загрузке с присваиванием и обращении: graph --alloc-check
+    //(нужна сборка с GRAPH_ALLOC_CHECK)
+    if (argc >= 2 && string(argv[1]) == "--alloc-check") {
+        try {
+            return alloccheck::run() ? 0 : 1;
+        }
+        catch (const exception& e) {
+            cout << e.what() << "\n";
+            return 1;
+        }
+    }
+
     int mainOption;
     string filename;
     Graph graph;